@@ -10,6 +10,8 @@
 namespace artery
 {
 
+constexpr std::size_t EnvironmentModelObject::NoIndex;
+
 const Position& BaseEnvironmentModelObject::getAttachmentPoint(const SensorPosition& pos) const
 {
     assert(mAttachmentPoints.size() == 4);
@@ -10,6 +10,7 @@
 #include "artery/envmod/sensor/SensorPosition.h"
 #include "artery/utility/Geometry.h"
 #include <vanetza/units/length.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -26,6 +27,7 @@ class EnvironmentModelObject
 public:
     using Length = vanetza::units::Length;
     using Heading = Angle;
+    static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
     virtual ~EnvironmentModelObject() = default;
 
     /**
@@ -89,6 +91,21 @@ public:
      * Vehicles should always be visible. Persons might be driving a vehicle and should not be visibile while doing so.
      */
     virtual bool isVisible() = 0;
+
+    /**
+     * Returns whether the object stands still
+     *
+     * Objects are considered moving unless they know better.
+     */
+    virtual bool isStationary() const { return false; }
+
+    /**
+     * Returns the object's index in the GlobalEnvironmentModel
+     *
+     * An index is stable during the object's lifetime but may be reused afterwards.
+     * @return index or NoIndex if object is not indexed
+     */
+    virtual std::size_t getObjectIndex() const { return NoIndex; }
 };
 
 } // namespace artery
@@ -7,17 +7,20 @@
 #include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/TraCIEnvironmentModelObject.h"
+#include "artery/envmod/sensor/FovSensor.h"
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/traci/Cast.h"
 #include "artery/traci/ControllableVehicle.h"
 #include "artery/traci/ControllablePerson.h"
 #include "artery/utility/IdentityRegistry.h"
+#include "artery/utility/WorkerPool.h"
 #include "traci/Core.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <algorithm>
 #include <array>
+#include <chrono>
 
 using namespace omnetpp;
 
@@ -29,6 +32,9 @@ Define_Module(GlobalEnvironmentModel)
 
 namespace {
 const simsignal_t refreshSignal = cComponent::registerSignal("EnvironmentModel.refresh");
+const simsignal_t obstaclesLoadedSignal = cComponent::registerSignal("EnvironmentModel.obstaclesLoaded");
+const simsignal_t rtreeUpdateTimeSignal = cComponent::registerSignal("EnvironmentModel.objectRtreeUpdateTime");
+const simsignal_t rtreeReinsertionsSignal = cComponent::registerSignal("EnvironmentModel.objectRtreeReinsertions");
 const simsignal_t traciInitSignal = cComponent::registerSignal("traci.init");
 const simsignal_t traciCloseSignal = cComponent::registerSignal("traci.close");
 const simsignal_t traciNodeAddSignal = cComponent::registerSignal("traci.node.add");
@@ -66,8 +72,29 @@ void GlobalEnvironmentModel::refresh()
     for (auto& object_kv : mObjects) {
         object_kv.second->update();
     }
+    mObjectOutlines.transform();
+    for (auto& object_kv : mObjects) {
+        object_kv.second->fetchOutline();
+    }
 
-    buildObjectRtree();
+    const auto rtreeUpdateStart = std::chrono::steady_clock::now();
+    std::size_t reinsertions = 0;
+    if (mObjectRtreeMode == ObjectRtreeMode::Incremental) {
+        reinsertions = updateObjectRtree();
+    } else {
+        buildObjectRtree();
+        reinsertions = mObjects.size();
+    }
+    const std::chrono::duration<double> rtreeUpdateTime = std::chrono::steady_clock::now() - rtreeUpdateStart;
+    emit(rtreeUpdateTimeSignal, rtreeUpdateTime.count());
+    emit(rtreeReinsertionsSignal, static_cast<unsigned long>(reinsertions));
+
+    if (mBatchedPreselection) {
+        preselectSensorCones();
+        if (mDetectionWorkers) {
+            detectSensorCones();
+        }
+    }
 
     if (mDrawVehicles) {
         int numObjects = mObjects.size();
@@ -115,13 +142,21 @@ bool GlobalEnvironmentModel::addObject(traci::Controller* controller)
         }
     }
 
-    auto object = std::make_shared<TraCIEnvironmentModelObject>(controller, id);
+    const ObjectOutlines::Slot slot = mObjectOutlines.allocate();
+    auto object = std::make_shared<TraCIEnvironmentModelObject>(controller, id, mObjectOutlines, slot);
     auto insertion = mObjects.emplace(object->getExternalId(), object);
     if (insertion.second) {
-        auto box = boost::geometry::return_envelope<geometry::Box>(object->getOutline());
+        invalidateSensorPreselections();
+        auto box = makeObjectBox(mObjectOutlines.getEnvelope(slot));
+        if (mObjectRtreeMode == ObjectRtreeMode::Incremental) {
+            mObjectBoxes.resize(mObjectOutlines.capacity());
+            mObjectBoxes[slot] = box;
+        }
         mObjectRtree.insert(ObjectRtreeValue { std::move(box), object });
+    } else {
+        mObjectOutlines.release(slot);
     }
-    ASSERT(mObjects.size() == mObjectRtree.size());
+    ASSERT(mTainted || mObjects.size() == mObjectRtree.size());
     return insertion.second;
 }
 
@@ -172,27 +207,226 @@ void GlobalEnvironmentModel::buildObjectRtree()
     {
         inline ObjectRtreeValue operator()(const ObjectDB::value_type& obj_kv) const
         {
-            const std::shared_ptr<EnvironmentModelObject>& obj = obj_kv.second;
-            auto box = boost::geometry::return_envelope<geometry::Box>(obj->getOutline());
-            return ObjectRtreeValue { std::move(box), obj };
+            const std::shared_ptr<TraCIEnvironmentModelObject>& obj = obj_kv.second;
+            return ObjectRtreeValue { outlines.getEnvelope(obj->getOutlineSlot()), obj };
         }
+
+        const ObjectOutlines& outlines;
     };
 
     // use bulk loading for efficient packing
-    mObjectRtree = ObjectRtree { mObjects | boost::adaptors::transformed(envelope_maker()) };
+    mObjectRtree = ObjectRtree { mObjects | boost::adaptors::transformed(envelope_maker { mObjectOutlines }) };
+    mTainted = false;
+}
+
+std::size_t GlobalEnvironmentModel::updateObjectRtree()
+{
+    std::size_t reinsertions = 0;
+    for (const auto& object_kv : mObjects) {
+        const std::shared_ptr<TraCIEnvironmentModelObject>& obj = object_kv.second;
+        geometry::Box& storedBox = mObjectBoxes[obj->getOutlineSlot()];
+        const geometry::Box envelope = mObjectOutlines.getEnvelope(obj->getOutlineSlot());
+        if (!boost::geometry::covered_by(envelope, storedBox)) {
+            // object left its stored box: move it to its current (inflated) envelope
+            mObjectRtree.remove(ObjectRtreeValue { storedBox, obj });
+            storedBox = makeObjectBox(envelope);
+            mObjectRtree.insert(ObjectRtreeValue { storedBox, obj });
+            ++reinsertions;
+        }
+    }
+
+    ASSERT(mObjects.size() == mObjectRtree.size());
     mTainted = false;
+    return reinsertions;
+}
+
+geometry::Box GlobalEnvironmentModel::makeObjectBox(const geometry::Box& envelope) const
+{
+    namespace bg = boost::geometry;
+    geometry::Box box = envelope;
+    if (mObjectRtreeMode == ObjectRtreeMode::Incremental) {
+        bg::set<bg::min_corner, 0>(box, bg::get<bg::min_corner, 0>(box) - mObjectRtreeSlack);
+        bg::set<bg::min_corner, 1>(box, bg::get<bg::min_corner, 1>(box) - mObjectRtreeSlack);
+        bg::set<bg::max_corner, 0>(box, bg::get<bg::max_corner, 0>(box) + mObjectRtreeSlack);
+        bg::set<bg::max_corner, 1>(box, bg::get<bg::max_corner, 1>(box) + mObjectRtreeSlack);
+    }
+    return box;
 }
 
 bool GlobalEnvironmentModel::removeObject(const std::string& objectId)
 {
-    bool erased = mObjects.erase(objectId) > 0;
-    mTainted |= erased; /*< pending object rtree update */
-    return erased;
+    auto found = mObjects.find(objectId);
+    if (found == mObjects.end()) {
+        return false;
+    }
+
+    if (mObjectRtreeMode == ObjectRtreeMode::Incremental) {
+        // remove object from rtree in place, no rebuild required
+        const geometry::Box& box = mObjectBoxes[found->second->getOutlineSlot()];
+        mObjectRtree.remove(ObjectRtreeValue { box, found->second });
+    } else {
+        mTainted = true; /*< pending object rtree update */
+    }
+    mObjectOutlines.release(found->second->getOutlineSlot());
+
+    mObjects.erase(found);
+    invalidateSensorPreselections();
+    return true;
+}
+
+void GlobalEnvironmentModel::preselectSensorCones()
+{
+    namespace bg = boost::geometry;
+    namespace bgi = boost::geometry::index;
+    using ConeRtreeValue = std::pair<geometry::Box, SensorPreselection*>;
+    using ConeRtree = bgi::rtree<ConeRtreeValue, bgi::rstar<16>>;
+    ASSERT(!mTainted);
+
+    const SimTime now = simTime();
+    std::vector<ConeRtreeValue> cones;
+    std::vector<ConeRtreeValue> obstacleCones; /*< cones of sensors requiring obstacle candidates */
+    cones.reserve(mSensorPreselections.size());
+    for (auto& sensor_kv : mSensorPreselections) {
+        SensorPreselection& presel = sensor_kv.second;
+        presel.objects.clear();
+        presel.obstacles.clear();
+        presel.detected = false;
+        presel.valid = presel.due <= now;
+        if (!presel.valid) {
+            // sensor does not measure at this refresh
+            continue;
+        }
+        presel.cone = sensor_kv.first->createSensorCone();
+
+        // cones are placed from validated templates, thus checked only in debug builds
+        PreselectionArea::trusted(presel.cone.sensorCone, presel.cone.sensorConeBounds);
+        cones.emplace_back(presel.cone.sensorConeBounds, &presel);
+        if (sensor_kv.first->requiresObstacles()) {
+            obstacleCones.emplace_back(cones.back());
+        }
+    }
+
+    if (cones.empty()) {
+        return;
+    }
+
+    // bulk loading of sensor cones, each object is then looked up in this tree only once
+    const ConeRtree coneRtree { cones };
+    const geometry::Box conesBounds = coneRtree.bounds();
+
+    // results are appended in object rtree order, i.e. same order as by preselectObjects
+    for (auto it = mObjectRtree.qbegin(bgi::intersects(conesBounds)); it != mObjectRtree.qend(); ++it) {
+        const geometry::Box& objectBox = it->first;
+        const std::shared_ptr<EnvironmentModelObject>& object = it->second;
+        if (!object->isVisible()) {
+            continue;
+        }
+
+        std::string objectId = object->getExternalId();
+        for (auto cone = coneRtree.qbegin(bgi::intersects(objectBox)); cone != coneRtree.qend(); ++cone) {
+            SensorPreselection* presel = cone->second;
+            if (objectId != presel->ego && bg::intersects(objectBox, presel->cone.sensorCone)) {
+                presel->objects.push_back(&object);
+            }
+        }
+    }
+
+    // sensors not requiring obstacles (e.g. RSU sensors with occlusion mask) are left out of the obstacle join
+    if (obstacleCones.empty()) {
+        return;
+    }
+
+    // join from the smaller set of obstacles or cones into the other rtree
+    if (mObstacleRtree.size() < obstacleCones.size()) {
+        const ConeRtree obstacleConeRtree { obstacleCones };
+        const geometry::Box obstacleConesBounds = obstacleConeRtree.bounds();
+        for (auto it = mObstacleRtree.qbegin(bgi::intersects(obstacleConesBounds)); it != mObstacleRtree.qend(); ++it) {
+            const geometry::Box& obstacleBox = it->first;
+            for (auto cone = obstacleConeRtree.qbegin(bgi::intersects(obstacleBox)); cone != obstacleConeRtree.qend(); ++cone) {
+                SensorPreselection* presel = cone->second;
+                if (bg::intersects(obstacleBox, presel->cone.sensorCone)) {
+                    presel->obstacles.push_back(&it->second);
+                }
+            }
+        }
+    } else {
+        for (const ConeRtreeValue& cone : obstacleCones) {
+            SensorPreselection* presel = cone.second;
+            for (auto it = mObstacleRtree.qbegin(bgi::intersects(cone.first)); it != mObstacleRtree.qend(); ++it) {
+                if (bg::intersects(it->first, presel->cone.sensorCone)) {
+                    presel->obstacles.push_back(&it->second);
+                }
+            }
+        }
+    }
+}
+
+void GlobalEnvironmentModel::detectSensorCones()
+{
+    ASSERT(mDetectionWorkers);
+    std::vector<std::pair<const FovSensor*, SensorPreselection*>> sensors;
+    sensors.reserve(mSensorPreselections.size());
+    for (auto& sensor_kv : mSensorPreselections) {
+        SensorPreselection& presel = sensor_kv.second;
+        if (presel.valid && !sensor_kv.first->reusesDetection(presel.objects)) {
+            sensors.emplace_back(sensor_kv.first, &presel);
+        }
+    }
+
+    // global model is read-only while workers are busy, each worker writes only to its sensor's result
+    mDetectionWorkers->run(sensors.size(), [&sensors](std::size_t i) {
+        const FovSensor* sensor = sensors[i].first;
+        SensorPreselection& presel = *sensors[i].second;
+        presel.detection = sensor->detectObjects(presel.cone, presel.objects, presel.obstacles);
+        presel.detected = true;
+    });
+}
+
+void GlobalEnvironmentModel::invalidateSensorPreselections()
+{
+    for (auto& sensor_kv : mSensorPreselections) {
+        sensor_kv.second.valid = false;
+        sensor_kv.second.detected = false;
+    }
+}
+
+void GlobalEnvironmentModel::registerSensor(const FovSensor* sensor, const std::string& ego)
+{
+    SensorPreselection& presel = mSensorPreselections[sensor];
+    presel.ego = ego;
+    presel.valid = false;
+    presel.detected = false;
+}
+
+void GlobalEnvironmentModel::scheduleSensor(const FovSensor* sensor, const SimTime& due)
+{
+    auto found = mSensorPreselections.find(sensor);
+    if (found != mSensorPreselections.end()) {
+        found->second.due = due;
+    }
+}
+
+void GlobalEnvironmentModel::unregisterSensor(const FovSensor* sensor)
+{
+    mSensorPreselections.erase(sensor);
+}
+
+const GlobalEnvironmentModel::SensorPreselection* GlobalEnvironmentModel::getSensorPreselection(const FovSensor* sensor) const
+{
+    if (mBatchedPreselection) {
+        auto found = mSensorPreselections.find(sensor);
+        if (found != mSensorPreselections.end() && found->second.valid) {
+            return &found->second;
+        }
+    }
+    return nullptr;
 }
 
 void GlobalEnvironmentModel::removeObjects()
 {
     mObjects.clear();
+    mObjectOutlines.clear();
+    mObjectBoxes.clear();
     mObjectRtree.clear();
     mTainted = false;
 
@@ -240,11 +474,35 @@ void GlobalEnvironmentModel::initialize()
 
     std::string obstacleTypes = par("obstacleTypes");
     boost::split(mObstacleTypes, obstacleTypes, boost::is_any_of(" "));
+
+    const std::string rtreeUpdate = par("objectRtreeUpdate");
+    if (rtreeUpdate == "rebuild") {
+        mObjectRtreeMode = ObjectRtreeMode::Rebuild;
+    } else if (rtreeUpdate == "incremental") {
+        mObjectRtreeMode = ObjectRtreeMode::Incremental;
+    } else {
+        throw cRuntimeError("unknown object rtree update mode %s", rtreeUpdate.c_str());
+    }
+    mObjectRtreeSlack = par("objectRtreeSlack");
+    if (mObjectRtreeSlack < 0.0) {
+        throw cRuntimeError("object rtree slack must not be negative");
+    }
+
+    mBatchedPreselection = par("batchedPreselection");
+
+    const int detectionThreads = par("detectionThreads");
+    if (detectionThreads > 1) {
+        if (!mBatchedPreselection) {
+            throw cRuntimeError("parallel sensor detection requires batched preselection");
+        }
+        mDetectionWorkers.reset(new WorkerPool(detectionThreads));
+    }
 }
 
 void GlobalEnvironmentModel::finish()
 {
     removeObjects();
+    mDetectionWorkers.reset();
 }
 
 void GlobalEnvironmentModel::receiveSignal(cComponent* source, simsignal_t signal, const SimTime&, cObject*)
@@ -252,6 +510,7 @@ void GlobalEnvironmentModel::receiveSignal(cComponent* source, simsignal_t signa
     if (signal == traciInitSignal) {
         auto core = check_and_cast<traci::Core*>(source);
         fetchObstacles(*core->getAPI());
+        emit(obstaclesLoadedSignal, this);
     } else if (signal == traciCloseSignal) {
         clear();
     }
@@ -375,4 +634,30 @@ GlobalEnvironmentModel::preselectObstacles(const std::vector<Position>& area)
     return obstacles;
 }
 
+void GlobalEnvironmentModel::preselectObjects(const std::string& ego, const PreselectionArea& area, ObjectCandidates& candidates)
+{
+    ASSERT(!mTainted);
+    candidates.clear();
+
+    // cheap box query first, polygon is only tested against candidate boxes
+    ObjectRtree::const_query_iterator it = mObjectRtree.qbegin(boost::geometry::index::intersects(area.bounds()));
+    for (; it != mObjectRtree.qend(); ++it) {
+        if (it->second->getExternalId() != ego && it->second->isVisible() && boost::geometry::intersects(it->first, area.polygon())) {
+            candidates.push_back(&it->second);
+        }
+    }
+}
+
+void GlobalEnvironmentModel::preselectObstacles(const PreselectionArea& area, ObstacleCandidates& candidates)
+{
+    candidates.clear();
+
+    ObstacleRtree::const_query_iterator it = mObstacleRtree.qbegin(boost::geometry::index::intersects(area.bounds()));
+    for (; it != mObstacleRtree.qend(); ++it) {
+        if (boost::geometry::intersects(it->first, area.polygon())) {
+            candidates.push_back(&it->second);
+        }
+    }
+}
+
 } // namespace artery
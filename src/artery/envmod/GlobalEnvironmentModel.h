@@ -11,6 +11,8 @@
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
+#include "artery/envmod/ObjectOutlines.h"
+#include "artery/envmod/PreselectionArea.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/clistener.h>
@@ -32,7 +34,10 @@ namespace artery
 {
 
 class EnvironmentModelObstacle;
+class FovSensor;
 class IdentityRegistry;
+class TraCIEnvironmentModelObject;
+class WorkerPool;
 
 /**
  * The GlobalEnvironmentModel has the global view of all objects and obstacles
@@ -48,6 +53,22 @@ class IdentityRegistry;
 class GlobalEnvironmentModel : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
+    /**
+     * Candidates for a sensor's detection as determined by batched preselection
+     */
+    struct SensorPreselection
+    {
+        SensorDetection cone; /*< sensor origin and cone */
+        ObjectCandidates objects;
+        ObstacleCandidates obstacles;
+        std::string ego; /*< ego object of sensor, filtered out of objects */
+        omnetpp::SimTime due; /*< next measurement of sensor, not preselected before */
+        bool valid = false; /*< true if candidates reflect the latest refresh */
+
+        SensorDetection detection; /*< detection result of parallel sensor evaluation */
+        bool detected = false; /*< true if detection has been evaluated for latest refresh */
+    };
+
     GlobalEnvironmentModel();
     virtual ~GlobalEnvironmentModel();
 
@@ -83,6 +104,14 @@ public:
     std::vector<std::shared_ptr<EnvironmentModelObject>>
     preselectObjects(const std::string& ego, const std::vector<Position>& area);
 
+    /**
+     * Preselect all objects close to the given validated area
+     * @param ego identifier of the ego object, which is filtered out of the result
+     * @param area validated search polygon, its bounding box is used for rtree query
+     * @param candidates buffer receiving preselected objects, its storage is reused
+     */
+    void preselectObjects(const std::string& ego, const PreselectionArea& area, ObjectCandidates& candidates);
+
     /**
      * Preselect all obstacles close to the given area
      * @param area search polygon
@@ -91,6 +120,54 @@ public:
     std::vector<std::shared_ptr<EnvironmentModelObstacle>>
     preselectObstacles(const std::vector<Position>& area);
 
+    /**
+     * Preselect all obstacles close to the given validated area
+     * @param area validated search polygon, its bounding box is used for rtree query
+     * @param candidates buffer receiving preselected obstacles, its storage is reused
+     */
+    void preselectObstacles(const PreselectionArea& area, ObstacleCandidates& candidates);
+
+    /**
+     * Register a sensor for batched preselection
+     *
+     * Sensor cones of all registered sensors are preselected at once
+     * before the refresh signal is emitted if batched preselection is enabled.
+     * @param sensor sensor to register
+     * @param ego identifier of the sensor's ego object
+     */
+    void registerSensor(const FovSensor* sensor, const std::string& ego);
+
+    /**
+     * Set next measurement time of a registered sensor
+     *
+     * Batched preselection and detection skip sensors until their measurement is due.
+     * Sensors without schedule are preselected at every refresh.
+     * @param sensor registered sensor
+     * @param due time of sensor's next measurement
+     */
+    void scheduleSensor(const FovSensor* sensor, const omnetpp::SimTime& due);
+
+    /**
+     * Unregister a sensor from batched preselection
+     * @param sensor previously registered sensor
+     */
+    void unregisterSensor(const FovSensor* sensor);
+
+    /**
+     * Get batched preselection result of a sensor
+     * @param sensor registered sensor
+     * @return preselection result or nullptr if not available for latest refresh
+     */
+    const SensorPreselection* getSensorPreselection(const FovSensor* sensor) const;
+
+    /**
+     * Get geometry of all objects stored as structure of arrays
+     *
+     * Objects can be looked up in this store by their slot.
+     * @return object geometry store, refreshed along with objects
+     */
+    const ObjectOutlines& getObjectOutlines() const { return mObjectOutlines; }
+
 private:
     /**
      * Refresh all dynamic objects in the database.
@@ -135,6 +212,39 @@ private:
      */
     void buildObjectRtree();
 
+    /**
+     * Preselect objects and obstacles for all registered sensors due at this refresh by a spatial join
+     */
+    void preselectSensorCones();
+
+    /**
+     * Evaluate detections of all preselected sensors concurrently on the worker pool
+     *
+     * Each sensor's detection is computed independently from its batched preselection,
+     * thus results do not depend on the number of threads.
+     * Sensors reusing their previous detection of a stationary scene are skipped.
+     */
+    void detectSensorCones();
+
+    /**
+     * Mark batched preselection results as outdated, e.g. because objects were added or removed
+     */
+    void invalidateSensorPreselections();
+
+    /**
+     * Update the object rtree incrementally.
+     * Only objects whose envelope left their stored (inflated) box are re-inserted.
+     * @return number of re-inserted objects
+     */
+    std::size_t updateObjectRtree();
+
+    /**
+     * Get the box stored in object rtree for an object envelope
+     * @param envelope object envelope
+     * @return envelope box, inflated by slack margin in incremental mode
+     */
+    geometry::Box makeObjectBox(const geometry::Box& envelope) const;
+
     /**
      * Clears the internal database completely
      */
@@ -153,17 +263,28 @@ private:
      */
     virtual traci::Controller* getController(omnetpp::cModule* mod);
 
-    using ObjectDB = std::unordered_map<std::string, std::shared_ptr<EnvironmentModelObject>>;
+    enum class ObjectRtreeMode { Rebuild, Incremental };
+
+    using ObjectDB = std::unordered_map<std::string, std::shared_ptr<TraCIEnvironmentModelObject>>;
+    using ObjectBoxes = std::vector<geometry::Box>;
     using ObjectRtreeValue = std::pair<geometry::Box, std::shared_ptr<EnvironmentModelObject>>;
     using ObjectRtree = boost::geometry::index::rtree<ObjectRtreeValue, boost::geometry::index::quadratic<16>>;
     using ObstacleDB = std::unordered_map<std::string, std::shared_ptr<EnvironmentModelObstacle>>;
     using ObstacleRtreeValue = std::pair<geometry::Box, std::shared_ptr<EnvironmentModelObstacle>>;
     using ObstacleRtree = boost::geometry::index::rtree<ObstacleRtreeValue, boost::geometry::index::rstar<16>>;
+    using SensorPreselections = std::unordered_map<const FovSensor*, SensorPreselection>;
 
     ObjectDB mObjects;
     ObjectRtree mObjectRtree;
+    ObjectOutlines mObjectOutlines;
+    ObjectBoxes mObjectBoxes; /*< boxes stored in object rtree indexed by slot (incremental mode only) */
+    ObjectRtreeMode mObjectRtreeMode = ObjectRtreeMode::Rebuild;
+    double mObjectRtreeSlack = 0.0;
     ObstacleDB mObstacles;
     ObstacleRtree mObstacleRtree;
+    SensorPreselections mSensorPreselections;
+    bool mBatchedPreselection = false;
+    std::unique_ptr<WorkerPool> mDetectionWorkers;
     IdentityRegistry* mIdentityRegistry;
     bool mTainted = false;
     omnetpp::cGroupFigure* mDrawObstacles = nullptr;
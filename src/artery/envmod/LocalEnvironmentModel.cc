@@ -12,6 +12,7 @@
 #include "artery/utility/FilterRules.h"
 #include <inet/common/ModuleAccess.h>
 #include <omnetpp/cxmlelement.h>
+#include <algorithm>
 #include <utility>
 
 using namespace omnetpp;
@@ -44,6 +45,7 @@ void LocalEnvironmentModel::initialize(int stage)
         Facilities& fac = mMiddleware->getFacilities();
         fac.register_mutable(mGlobalEnvironmentModel);
         fac.register_mutable(this);
+        mStaggerMeasurements = par("staggerMeasurements");
     } else if (stage == 1) {
         initializeSensors();
     }
@@ -53,14 +55,14 @@ void LocalEnvironmentModel::finish()
 {
     mGlobalEnvironmentModel->unsubscribe(EnvironmentModelRefreshSignal, this);
     mObjects.clear();
+    mObjectIndices.clear();
+    mObjectSlots.clear();
 }
 
 void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
 {
     if (signal == EnvironmentModelRefreshSignal) {
-        for (auto* sensor : mSensors) {
-            sensor->measurement();
-        }
+        measureSensors();
         update();
     }
 }
@@ -68,27 +70,102 @@ void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObje
 void LocalEnvironmentModel::complementObjects(const SensorDetection& detection, const Sensor& sensor)
 {
    for (auto& detectedObject : detection.objects) {
-      auto foundObject = mObjects.find(detectedObject);
-      if (foundObject != mObjects.end()) {
-         Tracking& tracking = foundObject->second;
-         tracking.tap(&sensor);
+      if (!detectedObject) {
+         continue;
+      }
+
+      Tracking* tracking = findTracking(detectedObject);
+      if (tracking) {
+         tracking->tap(&sensor);
       } else {
-         mObjects.emplace(detectedObject, Tracking { ++mTrackingCounter, &sensor });
+         const std::size_t index = detectedObject->getObjectIndex();
+         if (index != EnvironmentModelObject::NoIndex) {
+            if (index >= mObjectIndices.size()) {
+               mObjectIndices.resize(index + 1, EnvironmentModelObject::NoIndex);
+            }
+            // a stale entry of a removed object sharing this index is erased by next update
+            mObjectIndices[index] = mObjects.size();
+         }
+         mObjects.emplace_back(detectedObject, Tracking { ++mTrackingCounter, &sensor });
+         mObjectSlots.push_back(index);
       }
    }
 }
 
+LocalEnvironmentModel::Tracking* LocalEnvironmentModel::findTracking(const std::shared_ptr<EnvironmentModelObject>& object)
+{
+    // compare ownership to tell apart objects sharing an index without touching reference counts
+    auto same_object = [&object](const TrackedObject& tracked) {
+        return !tracked.first.owner_before(object) && !object.owner_before(tracked.first);
+    };
+
+    const std::size_t index = object->getObjectIndex();
+    if (index != EnvironmentModelObject::NoIndex) {
+        if (index < mObjectIndices.size()) {
+            const std::size_t pos = mObjectIndices[index];
+            if (pos != EnvironmentModelObject::NoIndex && same_object(mObjects[pos])) {
+                return &mObjects[pos].second;
+            }
+        }
+        return nullptr;
+    }
+
+    auto found = std::find_if(mObjects.begin(), mObjects.end(), same_object);
+    return found != mObjects.end() ? &found->second : nullptr;
+}
+
+void LocalEnvironmentModel::eraseTracking(std::size_t pos)
+{
+    const std::size_t last = mObjects.size() - 1;
+    const std::size_t index = mObjectSlots[pos];
+    if (index != EnvironmentModelObject::NoIndex && mObjectIndices[index] == pos) {
+        mObjectIndices[index] = EnvironmentModelObject::NoIndex;
+    }
+
+    if (pos != last) {
+        mObjects[pos] = std::move(mObjects[last]);
+        mObjectSlots[pos] = mObjectSlots[last];
+        const std::size_t movedIndex = mObjectSlots[pos];
+        if (movedIndex != EnvironmentModelObject::NoIndex && mObjectIndices[movedIndex] == last) {
+            mObjectIndices[movedIndex] = pos;
+        }
+    }
+
+    mObjects.pop_back();
+    mObjectSlots.pop_back();
+}
+
+void LocalEnvironmentModel::measureSensors()
+{
+    const SimTime now = simTime();
+    for (std::size_t i = 0; i < mSensors.size(); ++i) {
+        SimTime& next = mNextMeasurements[i];
+        if (next <= now) {
+            mSensors[i]->measurement();
+
+            const SimTime interval = mSensors[i]->getMeasurementInterval();
+            if (interval > SimTime::ZERO) {
+                // keep measurement phase, refresh steps may be coarser than interval
+                while (next <= now) {
+                    next += interval;
+                }
+                mSensors[i]->scheduleMeasurement(next);
+            }
+        }
+    }
+}
+
 void LocalEnvironmentModel::update()
 {
-    for (auto it = mObjects.begin(); it != mObjects.end();) {
-        const Object& object = it->first;
-        Tracking& tracking = it->second;
+    for (std::size_t pos = 0; pos < mObjects.size();) {
+        const Object& object = mObjects[pos].first;
+        Tracking& tracking = mObjects[pos].second;
         tracking.update();
 
         if (object.expired() || tracking.expired()) {
-            it = mObjects.erase(it);
+            eraseTracking(pos);
         } else {
-            ++it;
+            ++pos;
         }
     }
 }
@@ -128,6 +205,18 @@ void LocalEnvironmentModel::initializeSensors()
             module->scheduleStart(simTime());
             module->callInitialize();
             mSensors.push_back(sensor);
+
+            const SimTime interval = sensor->getMeasurementInterval();
+            if (interval > sensor->getValidityPeriod()) {
+                EV_WARN << "measurement interval of sensor " << sensor_name << " exceeds its validity period\n";
+            }
+            SimTime offset = SimTime::ZERO;
+            if (mStaggerMeasurements && interval > SimTime::ZERO) {
+                // spread measurements of sensors with equal intervals over time
+                offset = uniform(SimTime::ZERO, interval);
+            }
+            mNextMeasurements.push_back(simTime() + offset);
+            sensor->scheduleMeasurement(mNextMeasurements.back());
         }
     }
 }
@@ -135,7 +224,7 @@ void LocalEnvironmentModel::initializeSensors()
 
 LocalEnvironmentModel::Tracking::Tracking(int id, const Sensor* sensor) : mId(id)
 {
-    mSensors.emplace(sensor, TrackingTime {});
+    mSensors.emplace_back(sensor, TrackingTime {});
 }
 
 bool LocalEnvironmentModel::Tracking::expired() const
@@ -145,27 +234,25 @@ bool LocalEnvironmentModel::Tracking::expired() const
 
 void LocalEnvironmentModel::Tracking::update()
 {
-    for (auto it = mSensors.begin(); it != mSensors.end();) {
-      const Sensor* sensor = it->first;
-      const TrackingTime& tracking = it->second;
-
-      const bool expired = tracking.last() + sensor->getValidityPeriod() < simTime();
-      if (expired) {
-          it = mSensors.erase(it);
-      } else {
-          ++it;
-      }
-    }
+    const SimTime now = simTime();
+    auto expired = std::remove_if(mSensors.begin(), mSensors.end(),
+            [&now](const TrackingMap::value_type& sensor_tracking) {
+                const Sensor* sensor = sensor_tracking.first;
+                const TrackingTime& tracking = sensor_tracking.second;
+                return tracking.last() + sensor->getValidityPeriod() < now;
+            });
+    mSensors.erase(expired, mSensors.end());
 }
 
 void LocalEnvironmentModel::Tracking::tap(const Sensor* sensor)
 {
-    auto found = mSensors.find(sensor);
+    auto found = std::find_if(mSensors.begin(), mSensors.end(),
+            [sensor](const TrackingMap::value_type& sensor_tracking) { return sensor_tracking.first == sensor; });
     if (found != mSensors.end()) {
          TrackingTime& tracking = found->second;
          tracking.tap();
     } else {
-         mSensors.emplace(sensor, TrackingTime {});
+         mSensors.emplace_back(sensor, TrackingTime {});
     }
 }
 
@@ -7,14 +7,15 @@
 #ifndef LOCALENVIRONMENTMODEL_H_
 #define LOCALENVIRONMENTMODEL_H_
 
+#include <boost/container/small_vector.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
 #include <functional>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace artery
@@ -54,7 +55,10 @@ public:
     class Tracking
     {
     public:
-        using TrackingMap = std::map<const Sensor*, TrackingTime>;
+        /**
+         * Tracking times of sensors, stored inline for a few sensors.
+         */
+        using TrackingMap = boost::container::small_vector<std::pair<const Sensor*, TrackingTime>, 4>;
 
         Tracking(int id, const Sensor* sensor);
 
@@ -70,8 +74,8 @@ public:
         TrackingMap mSensors;
     };
 
-    using TrackedObjects = std::map<Object, Tracking, std::owner_less<Object>>;
-    using TrackedObject = typename TrackedObjects::value_type;
+    using TrackedObject = std::pair<Object, Tracking>;
+    using TrackedObjects = std::vector<TrackedObject>;
 
 
     LocalEnvironmentModel();
@@ -112,11 +116,33 @@ public:
 private:
     void initializeSensors();
 
+    /**
+     * Let all sensors measure whose measurement interval has passed
+     */
+    void measureSensors();
+
+    /**
+     * Find tracking of an object
+     * @param object detected object
+     * @return tracking or nullptr if object is not tracked yet
+     */
+    Tracking* findTracking(const std::shared_ptr<EnvironmentModelObject>& object);
+
+    /**
+     * Remove tracked object by swapping it with the last entry
+     * @param pos position in tracked objects
+     */
+    void eraseTracking(std::size_t pos);
+
     Middleware* mMiddleware;
     GlobalEnvironmentModel* mGlobalEnvironmentModel;
     int mTrackingCounter = 0;
-    TrackedObjects mObjects;
+    TrackedObjects mObjects; /*< flat table of tracked objects, unordered */
+    std::vector<std::size_t> mObjectIndices; /*< position in mObjects by global object index */
+    std::vector<std::size_t> mObjectSlots; /*< global object index by position in mObjects */
     std::vector<Sensor*> mSensors;
+    std::vector<omnetpp::SimTime> mNextMeasurements; /*< next measurement time of each sensor */
+    bool mStaggerMeasurements = false;
 };
 
 using TrackedObjectsFilterPredicate = std::function<bool(const LocalEnvironmentModel::TrackedObject&)>;
@@ -0,0 +1,194 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/ObjectOutlines.h"
+#include <cassert>
+#include <cmath>
+
+namespace artery
+{
+
+ObjectOutlines::Slot ObjectOutlines::allocate()
+{
+    if (!mFreeSlots.empty()) {
+        Slot slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        return slot;
+    }
+
+    const Slot slot = mFrontX.size();
+    const std::size_t size = slot + 1;
+    for (auto* column : { &mFrontX, &mFrontY, &mHeading, &mLength, &mWidth,
+            &mRadius, &mCentreX, &mCentreY, &mMinX, &mMinY, &mMaxX, &mMaxY }) {
+        column->resize(size, 0.0);
+    }
+    for (std::size_t i = 0; i < Corners; ++i) {
+        mCornerX[i].resize(size, 0.0);
+        mCornerY[i].resize(size, 0.0);
+    }
+    for (std::size_t i = 0; i < AttachmentPoints; ++i) {
+        mAttachmentX[i].resize(size, 0.0);
+        mAttachmentY[i].resize(size, 0.0);
+    }
+    return slot;
+}
+
+void ObjectOutlines::release(Slot slot)
+{
+    assert(slot < capacity());
+    // released slots are still transformed, a degenerated object at the origin costs nothing
+    setDimensions(slot, 0.0, 0.0);
+    mFrontX[slot] = 0.0;
+    mFrontY[slot] = 0.0;
+    mHeading[slot] = 0.0;
+    mFreeSlots.push_back(slot);
+}
+
+void ObjectOutlines::clear()
+{
+    mFreeSlots.clear();
+    for (Slot slot = capacity(); slot > 0; --slot) {
+        release(slot - 1);
+    }
+}
+
+void ObjectOutlines::setDimensions(Slot slot, double length, double width)
+{
+    assert(slot < capacity());
+    mLength[slot] = length;
+    mWidth[slot] = width;
+}
+
+void ObjectOutlines::setPose(Slot slot, const Position& front, Angle heading)
+{
+    assert(slot < capacity());
+    mFrontX[slot] = front.x.value();
+    mFrontY[slot] = front.y.value();
+    mHeading[slot] = heading.radian();
+}
+
+void ObjectOutlines::transform()
+{
+    transform(0, capacity());
+}
+
+void ObjectOutlines::transform(Slot slot)
+{
+    assert(slot < capacity());
+    transform(slot, slot + 1);
+}
+
+void ObjectOutlines::transform(Slot first, Slot last)
+{
+    // plain arrays without aliasing between columns allow the compiler to vectorise this loop
+    const double* const frontX = mFrontX.data();
+    const double* const frontY = mFrontY.data();
+    const double* const heading = mHeading.data();
+    const double* const length = mLength.data();
+    const double* const width = mWidth.data();
+    double* const radius = mRadius.data();
+    double* const centreX = mCentreX.data();
+    double* const centreY = mCentreY.data();
+    double* const flX = mCornerX[0].data();
+    double* const flY = mCornerY[0].data();
+    double* const frX = mCornerX[1].data();
+    double* const frY = mCornerY[1].data();
+    double* const brX = mCornerX[2].data();
+    double* const brY = mCornerY[2].data();
+    double* const blX = mCornerX[3].data();
+    double* const blY = mCornerY[3].data();
+    double* const frontPointX = mAttachmentX[0].data();
+    double* const frontPointY = mAttachmentY[0].data();
+    double* const rightPointX = mAttachmentX[1].data();
+    double* const rightPointY = mAttachmentY[1].data();
+    double* const backPointX = mAttachmentX[2].data();
+    double* const backPointY = mAttachmentY[2].data();
+    double* const leftPointX = mAttachmentX[3].data();
+    double* const leftPointY = mAttachmentY[3].data();
+    double* const minX = mMinX.data();
+    double* const minY = mMinY.data();
+    double* const maxX = mMaxX.data();
+    double* const maxY = mMaxY.data();
+
+    for (Slot i = first; i < last; ++i) {
+        // rotation matches boost::geometry's rotate_transformer, i.e. (1, 0) is mapped onto (cos, -sin)
+        const double c = std::cos(heading[i]);
+        const double s = std::sin(heading[i]);
+
+        // half extents along object's length axis (pointing backwards) and width axis (pointing left)
+        const double halfLength = 0.5 * length[i];
+        const double halfWidth = 0.5 * width[i];
+        const double backX = -c * halfLength;
+        const double backY = s * halfLength;
+        const double leftX = s * halfWidth;
+        const double leftY = c * halfWidth;
+
+        const double midX = frontX[i] + backX;
+        const double midY = frontY[i] + backY;
+        centreX[i] = midX;
+        centreY[i] = midY;
+        radius[i] = std::sqrt(halfLength * halfLength + halfWidth * halfWidth);
+
+        flX[i] = frontX[i] + leftX;
+        flY[i] = frontY[i] + leftY;
+        frX[i] = frontX[i] - leftX;
+        frY[i] = frontY[i] - leftY;
+        brX[i] = midX + backX - leftX;
+        brY[i] = midY + backY - leftY;
+        blX[i] = midX + backX + leftX;
+        blY[i] = midY + backY + leftY;
+
+        frontPointX[i] = frontX[i];
+        frontPointY[i] = frontY[i];
+        rightPointX[i] = midX - leftX;
+        rightPointY[i] = midY - leftY;
+        backPointX[i] = midX + backX;
+        backPointY[i] = midY + backY;
+        leftPointX[i] = midX + leftX;
+        leftPointY[i] = midY + leftY;
+
+        // outline is symmetric around its centre point
+        const double extentX = std::abs(backX) + std::abs(leftX);
+        const double extentY = std::abs(backY) + std::abs(leftY);
+        minX[i] = midX - extentX;
+        minY[i] = midY - extentY;
+        maxX[i] = midX + extentX;
+        maxY[i] = midY + extentY;
+    }
+}
+
+Position ObjectOutlines::getCorner(Slot slot, std::size_t corner) const
+{
+    assert(slot < capacity() && corner < Corners);
+    return Position { mCornerX[corner][slot], mCornerY[corner][slot] };
+}
+
+Position ObjectOutlines::getAttachmentPoint(Slot slot, std::size_t point) const
+{
+    assert(slot < capacity() && point < AttachmentPoints);
+    return Position { mAttachmentX[point][slot], mAttachmentY[point][slot] };
+}
+
+Position ObjectOutlines::getCentrePoint(Slot slot) const
+{
+    assert(slot < capacity());
+    return Position { mCentreX[slot], mCentreY[slot] };
+}
+
+geometry::Box ObjectOutlines::getEnvelope(Slot slot) const
+{
+    assert(slot < capacity());
+    return geometry::Box { geometry::Point { mMinX[slot], mMinY[slot] }, geometry::Point { mMaxX[slot], mMaxY[slot] } };
+}
+
+void ObjectOutlines::copyOutline(Slot slot, std::vector<Position>& outline) const
+{
+    outline.resize(Corners);
+    for (std::size_t i = 0; i < Corners; ++i) {
+        outline[i] = getCorner(slot, i);
+    }
+}
+
+} // namespace artery
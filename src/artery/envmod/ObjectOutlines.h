@@ -0,0 +1,132 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_OBJECTOUTLINES_H_
+#define ENVMOD_OBJECTOUTLINES_H_
+
+#include "artery/utility/Geometry.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ObjectOutlines stores the geometry of all dynamic objects as structure of arrays.
+ *
+ * Each object occupies a slot which remains stable during the object's lifetime.
+ * Objects write their pose (front bumper position and heading) into their slot,
+ * whereas corners, attachment points, centre points and envelopes of all slots
+ * are computed at once by a single loop over contiguous arrays.
+ *
+ * Corners are ordered front left, front right, back right, back left.
+ * Attachment points are ordered front, right, back, left (see SensorPosition).
+ */
+class ObjectOutlines
+{
+public:
+    using Slot = std::size_t;
+    static constexpr std::size_t Corners = 4;
+    static constexpr std::size_t AttachmentPoints = 4;
+
+    /**
+     * Allocate a slot, previously released slots are reused
+     * @return allocated slot
+     */
+    Slot allocate();
+
+    /**
+     * Release a slot for reuse by another object
+     * @param slot previously allocated slot
+     */
+    void release(Slot slot);
+
+    /**
+     * Release all slots
+     */
+    void clear();
+
+    /**
+     * Set object dimensions of a slot
+     * @param slot allocated slot
+     * @param length object length
+     * @param width object width
+     */
+    void setDimensions(Slot slot, double length, double width);
+
+    /**
+     * Set object pose of a slot
+     * @param slot allocated slot
+     * @param front position of front bumper (middle)
+     * @param heading object orientation, east and counter-clockwise
+     */
+    void setPose(Slot slot, const Position& front, Angle heading);
+
+    /**
+     * Compute geometry of all slots from their poses
+     */
+    void transform();
+
+    /**
+     * Compute geometry of a single slot from its pose
+     * @param slot allocated slot
+     */
+    void transform(Slot slot);
+
+    /**
+     * Number of slots including released ones
+     * @return capacity
+     */
+    std::size_t capacity() const { return mFrontX.size(); }
+
+    Position getCorner(Slot slot, std::size_t corner) const;
+    Position getAttachmentPoint(Slot slot, std::size_t point) const;
+    Position getCentrePoint(Slot slot) const;
+    double getRadius(Slot slot) const { return mRadius[slot]; }
+    geometry::Box getEnvelope(Slot slot) const;
+
+    /**
+     * Copy the outline of a slot into a polygon
+     *
+     * The polygon's storage is reused, i.e. no allocation occurs after its first fill.
+     * @param slot allocated slot
+     * @param outline polygon receiving the corners
+     */
+    void copyOutline(Slot slot, std::vector<Position>& outline) const;
+
+    // direct access to corner arrays indexed by slot
+    const std::vector<double>& getCornersX(std::size_t corner) const { return mCornerX[corner]; }
+    const std::vector<double>& getCornersY(std::size_t corner) const { return mCornerY[corner]; }
+
+private:
+    void transform(Slot first, Slot last);
+
+    // input per slot
+    std::vector<double> mFrontX;
+    std::vector<double> mFrontY;
+    std::vector<double> mHeading;
+    std::vector<double> mLength;
+    std::vector<double> mWidth;
+
+    // output per slot
+    std::vector<double> mRadius;
+    std::vector<double> mCentreX;
+    std::vector<double> mCentreY;
+    std::array<std::vector<double>, Corners> mCornerX;
+    std::array<std::vector<double>, Corners> mCornerY;
+    std::array<std::vector<double>, AttachmentPoints> mAttachmentX;
+    std::array<std::vector<double>, AttachmentPoints> mAttachmentY;
+    std::vector<double> mMinX;
+    std::vector<double> mMinY;
+    std::vector<double> mMaxX;
+    std::vector<double> mMaxY;
+
+    std::vector<Slot> mFreeSlots;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_OBJECTOUTLINES_H_ */
@@ -0,0 +1,33 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/PreselectionArea.h"
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <omnetpp/cexception.h>
+#include <string>
+
+namespace artery
+{
+
+PreselectionArea PreselectionArea::validate(const std::vector<Position>& polygon, const geometry::Box& bounds)
+{
+    boost::geometry::validity_failure_type failure;
+    if (!boost::geometry::is_valid(polygon, failure)) {
+        std::string error_msg =  boost::geometry::validity_failure_type_message(failure);
+        throw omnetpp::cRuntimeError("preselection polygon is invalid: %s", error_msg.c_str());
+    }
+    return PreselectionArea { polygon, bounds };
+}
+
+PreselectionArea PreselectionArea::trusted(const std::vector<Position>& polygon, const geometry::Box& bounds)
+{
+#ifndef NDEBUG
+    return validate(polygon, bounds);
+#else
+    return PreselectionArea { polygon, bounds };
+#endif
+}
+
+} // namespace artery
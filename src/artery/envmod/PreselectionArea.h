@@ -0,0 +1,55 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_PRESELECTIONAREA_H_
+#define ENVMOD_PRESELECTIONAREA_H_
+
+#include "artery/utility/Geometry.h"
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * PreselectionArea refers to a search polygon whose validity has been established.
+ *
+ * Preselection queries accepting this handle do not check the polygon's validity again.
+ * The handle does not own the polygon and its bounding box, i.e. both have to outlive it.
+ */
+class PreselectionArea
+{
+public:
+    /**
+     * Check validity of polygon
+     * @param polygon search polygon
+     * @param bounds bounding box of polygon
+     * @return handle to valid polygon
+     * @throw omnetpp::cRuntimeError if polygon is invalid
+     */
+    static PreselectionArea validate(const std::vector<Position>& polygon, const geometry::Box& bounds);
+
+    /**
+     * Trust the producer of polygon, e.g. a cone placed from a validated SensorConeTemplate.
+     * Validity is only checked in debug builds.
+     * @param polygon search polygon
+     * @param bounds bounding box of polygon
+     * @return handle to valid polygon
+     */
+    static PreselectionArea trusted(const std::vector<Position>& polygon, const geometry::Box& bounds);
+
+    const std::vector<Position>& polygon() const { return *mPolygon; }
+    const geometry::Box& bounds() const { return *mBounds; }
+
+private:
+    PreselectionArea(const std::vector<Position>& polygon, const geometry::Box& bounds) :
+        mPolygon(&polygon), mBounds(&bounds) {}
+
+    const std::vector<Position>* mPolygon;
+    const geometry::Box* mBounds;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_PRESELECTIONAREA_H_ */
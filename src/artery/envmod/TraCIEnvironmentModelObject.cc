@@ -8,7 +8,6 @@
 #include "artery/envmod/TraCIEnvironmentModelObject.h"
 #include "artery/traci/PersonController.h"
 #include "artery/traci/VehicleController.h"
-#include <boost/geometry/strategies/transform/matrix_transformers.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
 #include <boost/units/systems/angle/degrees.hpp>
@@ -17,67 +16,12 @@
 namespace artery
 {
 
-namespace {
-
-// corner points of 1x1 square (heading east, front bumper at origin)
-const std::vector<Position> squareOutline = {
-    Position(0.0, 0.5), // front left
-    Position(0.0, -0.5), // front right
-    Position(-1.0, -0.5), // back right
-    Position(-1.0, 0.5) // back left
-};
-
-// attachment points for sensor
-const std::vector<Position> squareAttachmentPoints = {
-    Position(0.0, 0.0), // front middle
-    Position(-0.5, -0.5), // right middle
-    Position(-1.0, 0.0), // back middle
-    Position(-0.5, 0.5) // left middle
-};
-
-const Position squareCentrePoint(-0.5, 0.0);
-
-#if BOOST_VERSION < 106400
-boost::geometry::strategy::transform::ublas_transformer<double, 2, 2>
-transformObject(double length, double width, const Position& pos, Angle alpha)
-{
-    using namespace boost::geometry::strategy::transform;
-    using result_type = ublas_transformer<double, 2, 2>;
-    using matrix_type = boost::numeric::ublas::matrix<double>;
-
-    // scale square to vehicle dimensions
-    scale_transformer<double, 2, 2> scaling(length, width);
-    // rotate into driving direction
-    rotate_transformer<boost::geometry::radian, double, 2, 2> rotation(alpha.radian());
-    // move to given front bumper position
-    translate_transformer<double, 2, 2> translation(pos.x.value(), pos.y.value());
-
-    const matrix_type rotateAfterScale = prod(rotation.matrix(), scaling.matrix());
-    const matrix_type translateAfterRotateAfterScale = prod(translation.matrix(), rotateAfterScale);
-    return result_type { translateAfterRotateAfterScale };
-}
-#else
-boost::geometry::strategy::transform::matrix_transformer<double, 2, 2>
-transformObject(double length, double width, const Position& pos, Angle alpha)
-{
-    using namespace boost::geometry::strategy::transform;
-
-    // scale square to vehicle dimensions
-    scale_transformer<double, 2, 2> scaling(length, width);
-    // rotate into driving direction
-    rotate_transformer<boost::geometry::radian, double, 2, 2> rotation(alpha.radian());
-    // move to given front bumper position
-    translate_transformer<double, 2, 2> translation(pos.x.value(), pos.y.value());
-
-    return matrix_transformer<double, 2, 2> { translation.matrix() * rotation.matrix() * scaling.matrix() };
-}
-#endif
-
-}
-
-TraCIEnvironmentModelObject::TraCIEnvironmentModelObject(const traci::Controller* controller, uint32_t id) :
+TraCIEnvironmentModelObject::TraCIEnvironmentModelObject(const traci::Controller* controller, uint32_t id,
+        ObjectOutlines& outlines, ObjectOutlines::Slot slot) :
     VehicleDataProvider(id),
-    mController(controller)
+    mController(controller),
+    mOutlines(&outlines),
+    mOutlineSlot(slot)
 {
     mLength = controller->getLength();
     mWidth = controller->getWidth();
@@ -92,7 +36,11 @@ TraCIEnvironmentModelObject::TraCIEnvironmentModelObject(const traci::Controller
     else {
         setStationType(StationType::Pedestrian);
     }
+
+    mOutlines->setDimensions(mOutlineSlot, mLength.value(), mWidth.value());
     update();
+    mOutlines->transform(mOutlineSlot);
+    fetchOutline();
 }
 
 const VehicleDataProvider& TraCIEnvironmentModelObject::getVehicleData() const
@@ -105,16 +53,21 @@ void TraCIEnvironmentModelObject::update()
     // Update the internal vdp
     VehicleDataProvider::update(getKinematics(*mController));
 
-    // Recalculate all time and position dependent attributes
+    // Geometry of all objects is recalculated at once by the store
     using namespace boost::math::double_constants;
     Angle heading = -1.0 * (getVehicleData().heading() - 0.5 * pi * boost::units::si::radian);
-    auto affine = transformObject(mLength.value(), mWidth.value(), getVehicleData().position(), heading);
+    mOutlines->setPose(mOutlineSlot, getVehicleData().position(), heading);
+}
 
-    boost::geometry::transform(squareCentrePoint, mCentrePoint, affine);
-    mOutline.clear();
-    boost::geometry::transform(squareOutline, mOutline, affine);
-    mAttachmentPoints.clear();
-    boost::geometry::transform(squareAttachmentPoints, mAttachmentPoints, affine);
+void TraCIEnvironmentModelObject::fetchOutline()
+{
+    // storage of outline and attachment points is reused, no allocations after the first fetch
+    mOutlines->copyOutline(mOutlineSlot, mOutline);
+    mAttachmentPoints.resize(ObjectOutlines::AttachmentPoints);
+    for (std::size_t i = 0; i < ObjectOutlines::AttachmentPoints; ++i) {
+        mAttachmentPoints[i] = mOutlines->getAttachmentPoint(mOutlineSlot, i);
+    }
+    mCentrePoint = mOutlines->getCentrePoint(mOutlineSlot);
 }
 
 EnvironmentModelObject::Heading TraCIEnvironmentModelObject::getHeading() const
@@ -134,6 +87,11 @@ std::string TraCIEnvironmentModelObject::getExternalId() const
     return mController->getId();
 }
 
+bool TraCIEnvironmentModelObject::isStationary() const
+{
+    return getVehicleData().speed() == 0.0 * boost::units::si::meter_per_second;
+}
+
 bool TraCIEnvironmentModelObject::isVisible() {
     if (getStationType() == StationType::Pedestrian) {
         return !dynamic_cast<const traci::PersonController *>(mController)->isDriving();
@@ -9,6 +9,7 @@
 
 #include "artery/application/VehicleDataProvider.h"
 #include "artery/envmod/BaseEnvironmentModelObject.h"
+#include "artery/envmod/ObjectOutlines.h"
 
 // forward declarations
 namespace traci
@@ -26,22 +27,43 @@ public:
     /**
      * @param ctrl associated TraCI controller to this object
      * @param id station ID used by this object for application messages (e.g. CAM)
+     * @param outlines geometry store shared by all objects
+     * @param slot slot allocated for this object in geometry store
      */
-    TraCIEnvironmentModelObject(const traci::Controller*, uint32_t id);
+    TraCIEnvironmentModelObject(const traci::Controller*, uint32_t id, ObjectOutlines& outlines, ObjectOutlines::Slot slot);
 
     /**
      * Get access to vehicle data provider for this object.
      */
     const VehicleDataProvider& getVehicleData() const;
 
+    /**
+     * Update vehicle data and write the object's pose into its geometry store slot.
+     * Outline is not changed until fetchOutline() is called after the store's transformation.
+     */
     void update() override;
+
+    /**
+     * Copy outline, attachment and centre points from geometry store slot
+     */
+    void fetchOutline();
+
+    /**
+     * Get slot of this object in geometry store
+     */
+    ObjectOutlines::Slot getOutlineSlot() const { return mOutlineSlot; }
+
     Heading getHeading() const override;
     std::string getExternalId() const override;
     bool isVisible() override;
+    bool isStationary() const override;
+    std::size_t getObjectIndex() const override { return mOutlineSlot; }
 
 private:
 
     const traci::Controller* mController;
+    ObjectOutlines* mOutlines;
+    ObjectOutlines::Slot mOutlineSlot;
 };
 
 } // namespace artery
@@ -29,6 +29,7 @@ FovSensor::FovSensor() :
 
 void FovSensor::finish()
 {
+    mGlobalEnvironmentModel->unregisterSensor(this);
     if (mGroupFigure) {
         delete mGroupFigure->removeFromParent();
         mGroupFigure = nullptr;
@@ -63,40 +64,137 @@ void FovSensor::initialize()
     mFovConfig.fieldOfView.angle = par("fovAngle").doubleValue() * boost::units::degree::degrees;
     mFovConfig.numSegments = par("numSegments");
     mFovConfig.doLineOfSightCheck = par("doLineOfSightCheck");
+    mConeTemplate = SensorConeTemplate { mFovConfig };
+    mMeasurementInterval = par("measurementInterval");
+    mSkipStationary = par("skipStationary");
 
     initializeVisualization();
+    mGlobalEnvironmentModel->registerSensor(this, mFovConfig.egoID);
 }
 
 void FovSensor::measurement()
 {
     Enter_Method("measurement");
-    auto detection = detectObjects();
+    if (!mSkipStationary) {
+        auto detection = detectObjects();
+        mLocalEnvironmentModel->complementObjects(detection, *this);
+        mLastDetection = std::move(detection);
+        return;
+    }
+
+    // candidates are preselected only once for both stationarity check and detection
+    auto batched = mGlobalEnvironmentModel->getSensorPreselection(this);
+    SensorDetection cone;
+    if (!batched) {
+        cone = createSensorCone();
+        const auto area = PreselectionArea::trusted(cone.sensorCone, cone.sensorConeBounds);
+        mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, area, mObjectCandidates);
+    }
+    const ObjectCandidates& candidates = batched ? batched->objects : mObjectCandidates;
+
+    const bool stationary = isSceneStationary(candidates);
+    if (stationary && mStationaryScene) {
+        // nothing moved since previous detection: it is still valid, keep its objects tracked
+        // (same condition as reusesDetection(), so parallel detection has skipped this sensor)
+        mLocalEnvironmentModel->complementObjects(*mLastDetection, *this);
+        return;
+    }
+    mStationaryScene = stationary;
+    if (!stationary) {
+        mStationaryCandidates.clear();
+        for (const auto* candidate : candidates) {
+            mStationaryCandidates.push_back(*candidate);
+        }
+    }
+
+    auto detection = batched ? detectObjects() : detectPreselected(std::move(cone));
     mLocalEnvironmentModel->complementObjects(detection, *this);
     mLastDetection = std::move(detection);
 }
 
+void FovSensor::scheduleMeasurement(const SimTime& next)
+{
+    mGlobalEnvironmentModel->scheduleSensor(this, next);
+}
+
+bool FovSensor::reusesDetection(const ObjectCandidates& candidates) const
+{
+    return mSkipStationary && mStationaryScene && isSceneStationary(candidates);
+}
+
+bool FovSensor::isSceneStationary(const ObjectCandidates& candidates) const
+{
+    // sensors without ego object (e.g. RSU sensors) are stationary by themselves
+    auto ego = mGlobalEnvironmentModel->getObject(mFovConfig.egoID);
+    if (ego && !ego->isStationary()) {
+        return false;
+    }
+
+    // objects about to enter the sensor cone are among the candidates as well
+    if (candidates.size() != mStationaryCandidates.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        const std::shared_ptr<EnvironmentModelObject>& object = *candidates[i];
+        // weak reference keeps ownership block alive: a new object at a recycled address never matches
+        const std::weak_ptr<EnvironmentModelObject>& previous = mStationaryCandidates[i];
+        if (previous.owner_before(object) || object.owner_before(previous) || !object->isStationary()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 SensorDetection FovSensor::detectObjects() const
 {
-    namespace bg = boost::geometry;
     if (mFovConfig.fieldOfView.range <= 0.0 * boost::units::si::meter) {
         throw std::runtime_error("sensor range is 0 meter or less");
     } else if (mFovConfig.fieldOfView.angle > 360.0 * boost::units::degree::degrees) {
         throw std::runtime_error("sensor opening angle exceeds 360 degree");
     }
 
+    // use candidates of batched preselection if available
+    auto batched = mGlobalEnvironmentModel->getSensorPreselection(this);
+    if (batched && batched->detected) {
+        return batched->detection;
+    } else if (batched) {
+        return detectObjects(batched->cone, batched->objects, batched->obstacles);
+    }
+
     SensorDetection detection = createSensorCone();
-    auto preselObjectsInSensorRange = mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, detection.sensorCone);
+    // sensor cone is placed from a validated template
+    const auto area = PreselectionArea::trusted(detection.sensorCone, detection.sensorConeBounds);
+    mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, area, mObjectCandidates);
+    return detectPreselected(std::move(detection));
+}
 
+SensorDetection FovSensor::detectPreselected(SensorDetection detection) const
+{
     // get obstacles intersecting with sensor cone
-    auto obstacleIntersections = mGlobalEnvironmentModel->preselectObstacles(detection.sensorCone);
+    if (requiresObstacles()) {
+        const auto area = PreselectionArea::trusted(detection.sensorCone, detection.sensorConeBounds);
+        mGlobalEnvironmentModel->preselectObstacles(area, mObstacleCandidates);
+    } else {
+        mObstacleCandidates.clear();
+    }
+
+    return detectObjects(std::move(detection), mObjectCandidates, mObstacleCandidates);
+}
+
+SensorDetection FovSensor::detectObjects(SensorDetection detection,
+        const ObjectCandidates& preselObjectsInSensorRange,
+        const ObstacleCandidates& obstacleIntersections) const
+{
+    namespace bg = boost::geometry;
 
     if (mFovConfig.doLineOfSightCheck)
     {
         std::unordered_set<std::shared_ptr<EnvironmentModelObstacle>> blockingObstacles;
 
         // check if objects in sensor cone are hidden by another object or an obstacle
-        for (const auto& object : preselObjectsInSensorRange)
+        for (const auto* candidate : preselObjectsInSensorRange)
         {
+            const std::shared_ptr<EnvironmentModelObject>& object = *candidate;
             for (const auto& objectPoint : object->getOutline())
             {
                 // skip objects points outside of sensor cone
@@ -109,20 +207,15 @@ SensorDetection FovSensor::detectObjects() const
                 lineOfSight[1] = objectPoint;
 
                 bool noVehicleOccultation = std::none_of(preselObjectsInSensorRange.begin(), preselObjectsInSensorRange.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObject>& object) {
-                            return bg::crosses(lineOfSight, object->getOutline());
+                        [&](const std::shared_ptr<EnvironmentModelObject>* object) {
+                            return bg::crosses(lineOfSight, (*object)->getOutline());
                         });
 
-                bool noObstacleOccultation = std::none_of(obstacleIntersections.begin(), obstacleIntersections.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObstacle>& obstacle) {
-                            ASSERT(obstacle);
-                            if (bg::intersects(lineOfSight, obstacle->getOutline())) {
-                                blockingObstacles.insert(obstacle);
-                                return true;
-                            } else {
-                                return false;
-                            }
-                        });
+                auto blockingObstacle = findBlockingObstacle(detection.sensorOrigin, objectPoint, obstacleIntersections);
+                if (blockingObstacle) {
+                    blockingObstacles.insert(*blockingObstacle);
+                }
+                bool noObstacleOccultation = !blockingObstacle;
 
                 if (noVehicleOccultation && noObstacleOccultation) {
                     if (detection.objects.empty() || detection.objects.back() != object) {
@@ -141,11 +234,11 @@ SensorDetection FovSensor::detectObjects() const
 
         detection.obstacles.assign(blockingObstacles.begin(), blockingObstacles.end());
     } else {
-        for (const auto& object : preselObjectsInSensorRange) {
+        for (const auto* object : preselObjectsInSensorRange) {
             // preselection: object's bounding box and sensor cone's bounding box intersect
             // now: check if their actual geometries intersect somewhere
-            if (bg::intersects(object->getOutline(), detection.sensorCone)) {
-                detection.objects.push_back(object);
+            if (bg::intersects((*object)->getOutline(), detection.sensorCone)) {
+                detection.objects.push_back(*object);
             }
         }
     }
@@ -153,13 +246,35 @@ SensorDetection FovSensor::detectObjects() const
     return detection;
 }
 
+const std::shared_ptr<EnvironmentModelObstacle>* FovSensor::findBlockingObstacle(
+        const Position& origin, const Position& point, const ObstacleCandidates& obstacles) const
+{
+    LineOfSight lineOfSight;
+    lineOfSight[0] = origin;
+    lineOfSight[1] = point;
+
+    for (const auto* obstacle : obstacles) {
+        ASSERT(obstacle && *obstacle);
+        if (boost::geometry::intersects(lineOfSight, (*obstacle)->getOutline())) {
+            return obstacle;
+        }
+    }
+    return nullptr;
+}
+
+bool FovSensor::requiresObstacles() const
+{
+    // obstacles are only relevant for line of sight checks
+    return mFovConfig.doLineOfSightCheck;
+}
+
 SensorDetection FovSensor::createSensorCone() const
 {
     SensorDetection detection;
     const auto& egoObj = mGlobalEnvironmentModel->getObject(mFovConfig.egoID);
     if (egoObj) {
         detection.sensorOrigin = egoObj->getAttachmentPoint(mFovConfig.sensorPosition);
-        detection.sensorCone = createSensorArc(mFovConfig, *egoObj);
+        detection.sensorConeBounds = mConeTemplate.place(detection.sensorOrigin, egoObj->getHeading(), detection.sensorCone);
     } else {
         throw std::runtime_error("no object found for ID " + mFovConfig.egoID);
     }
@@ -213,6 +328,11 @@ const FieldOfView& FovSensor::getFieldOfView() const
     return mFovConfig.fieldOfView;
 }
 
+omnetpp::SimTime FovSensor::getMeasurementInterval() const
+{
+    return mMeasurementInterval;
+}
+
 omnetpp::SimTime FovSensor::getValidityPeriod() const
 {
     using namespace omnetpp;
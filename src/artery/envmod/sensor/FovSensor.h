@@ -30,6 +30,39 @@ public:
     const std::string getSensorName() const override;
     void setSensorName(const std::string& name) override;
     SensorDetection detectObjects() const override;
+    omnetpp::SimTime getMeasurementInterval() const override;
+    void scheduleMeasurement(const omnetpp::SimTime&) override;
+
+    /**
+     * Check if next measurement reuses the previous detection instead of detecting objects
+     * @param candidates objects preselected by the current sensor cone
+     * @return true if skipStationary is enabled and the scene is still stationary
+     */
+    bool reusesDetection(const ObjectCandidates& candidates) const;
+
+    /**
+     * Check if obstacle candidates need to be preselected for detection
+     */
+    virtual bool requiresObstacles() const;
+
+    /**
+     * Create sensor cone at sensor's current position and orientation
+     * @return detection with sensor origin and cone set
+     */
+    virtual SensorDetection createSensorCone() const;
+
+    /**
+     * Detect objects within a sensor cone among preselected candidates
+     *
+     * This method only reads the given candidates and sensor configuration.
+     * Hence, it may be invoked concurrently for different sensors.
+     * @param cone detection with sensor origin and cone set
+     * @param objects candidate objects
+     * @param obstacles candidate obstacles
+     * @return detection result
+     */
+    SensorDetection detectObjects(SensorDetection cone,
+            const ObjectCandidates& objects, const ObstacleCandidates& obstacles) const;
 
 protected:
     template<typename T>
@@ -50,9 +83,42 @@ protected:
     void finish() override;
     void initializeVisualization();
     void refreshDisplay() const override;
-    virtual SensorDetection createSensorCone() const;
+
+    /**
+     * Find a static obstacle blocking the line of sight between sensor and a point
+     * @param origin sensor origin
+     * @param point target point
+     * @param obstacles preselected obstacle candidates
+     * @return blocking obstacle or nullptr if no obstacle blocks the line of sight
+     */
+    virtual const std::shared_ptr<EnvironmentModelObstacle>* findBlockingObstacle(
+            const Position& origin, const Position& point, const ObstacleCandidates& obstacles) const;
+
+    /**
+     * Detect objects among candidates already preselected into mObjectCandidates
+     * @param detection detection with sensor origin and cone set
+     * @return detection result
+     */
+    SensorDetection detectPreselected(SensorDetection detection) const;
+
+    /**
+     * Check if the previous detection is still valid because nothing moved
+     *
+     * The scene is stationary if ego object and all objects preselected by
+     * the sensor cone stand still and are the same as at the previous detection.
+     * @param candidates objects preselected by the current sensor cone
+     * @return true if previous detection can be reused
+     */
+    bool isSceneStationary(const ObjectCandidates& candidates) const;
 
     SensorConfigFov mFovConfig;
+    SensorConeTemplate mConeTemplate;
+    mutable ObjectCandidates mObjectCandidates; /*< reused preselection buffer */
+    mutable ObstacleCandidates mObstacleCandidates; /*< reused preselection buffer */
+    omnetpp::SimTime mMeasurementInterval;
+    bool mSkipStationary = false;
+    std::vector<std::weak_ptr<EnvironmentModelObject>> mStationaryCandidates; /*< objects preselected by last full detection */
+    bool mStationaryScene = false; /*< true if last full detection saw a stationary scene */
     Updatable<SensorDetection> mLastDetection;
     bool mDrawLinesOfSight;
 
@@ -0,0 +1,106 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/sensor/OcclusionMask.h"
+#include "artery/envmod/EnvironmentModelObstacle.h"
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <limits>
+
+namespace artery
+{
+
+namespace
+{
+
+/**
+ * Distance along a ray to its first intersection with a polygon's edges
+ * @return distance or infinity if ray does not hit polygon within range
+ */
+double castRay(double ox, double oy, double dx, double dy, double range, const std::vector<Position>& polygon)
+{
+    double hit = std::numeric_limits<double>::infinity();
+    const std::size_t n = polygon.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        // polygons are open, i.e. last edge connects back to first point
+        const Position& a = polygon[i];
+        const Position& b = polygon[(i + 1) % n];
+        const double ex = b.x.value() - a.x.value();
+        const double ey = b.y.value() - a.y.value();
+        const double denom = dx * ey - dy * ex;
+        if (denom == 0.0) {
+            // parallel edges are hit by their adjacent edges anyway
+            continue;
+        }
+
+        const double ax = a.x.value() - ox;
+        const double ay = a.y.value() - oy;
+        const double t = (ax * ey - ay * ex) / denom;
+        const double u = (ax * dy - ay * dx) / denom;
+        if (t >= 0.0 && t <= range && u >= 0.0 && u <= 1.0 && t < hit) {
+            hit = t;
+        }
+    }
+    return hit;
+}
+
+} // namespace
+
+void OcclusionMask::build(const Position& origin, double range, Angle resolution, const ObstacleCandidates& obstacles)
+{
+    using boost::math::double_constants::pi;
+    using boost::math::double_constants::two_pi;
+    const std::size_t bins = std::ceil(two_pi / resolution.radian());
+
+    mOrigin = origin;
+    mBinWidth = two_pi / bins;
+    mFreeDistance.assign(bins, std::numeric_limits<double>::infinity());
+    mOccluders.assign(bins, nullptr);
+
+    const double ox = origin.x.value();
+    const double oy = origin.y.value();
+    for (const auto* obstacle : obstacles) {
+        const std::vector<Position>& outline = (*obstacle)->getOutline();
+        if (boost::geometry::covered_by(origin, outline)) {
+            // sensor is located within obstacle: every line of sight is blocked
+            mFreeDistance.assign(bins, 0.0);
+            mOccluders.assign(bins, *obstacle);
+            return;
+        }
+
+        for (std::size_t i = 0; i < bins; ++i) {
+            const double angle = -pi + (i + 0.5) * mBinWidth;
+            const double hit = castRay(ox, oy, std::cos(angle), std::sin(angle), range, outline);
+            if (hit < mFreeDistance[i]) {
+                mFreeDistance[i] = hit;
+                mOccluders[i] = *obstacle;
+            }
+        }
+    }
+}
+
+void OcclusionMask::clear()
+{
+    mFreeDistance.clear();
+    mOccluders.clear();
+}
+
+const std::shared_ptr<EnvironmentModelObstacle>* OcclusionMask::occluder(const Position& point) const
+{
+    using boost::math::double_constants::pi;
+    const double dx = point.x.value() - mOrigin.x.value();
+    const double dy = point.y.value() - mOrigin.y.value();
+    std::size_t bin = (std::atan2(dy, dx) + pi) / mBinWidth;
+    if (bin >= mFreeDistance.size()) {
+        // atan2 yields pi for points on the negative x axis, i.e. the first bin
+        bin = 0;
+    }
+
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    return distance < mFreeDistance[bin] ? nullptr : &mOccluders[bin];
+}
+
+} // namespace artery
@@ -0,0 +1,65 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_OCCLUSIONMASK_H_
+#define ENVMOD_OCCLUSIONMASK_H_
+
+#include "artery/envmod/sensor/SensorDetection.h"
+#include "artery/utility/Geometry.h"
+#include <memory>
+#include <vector>
+
+namespace artery
+{
+
+class EnvironmentModelObstacle;
+
+/**
+ * OcclusionMask is a polar map of static obstacles as seen from a stationary sensor.
+ *
+ * The full circle around the sensor is divided into bins of equal angular width.
+ * For each bin, a ray is cast along its centre and the distance to the closest
+ * obstacle is stored. A point is occluded if it is not closer to the sensor than
+ * the obstacle within the point's bin. Hence, the mask's accuracy depends on its resolution.
+ */
+class OcclusionMask
+{
+public:
+    /**
+     * Build mask from obstacles around origin
+     * @param origin sensor position
+     * @param range maximum distance of interest
+     * @param resolution angular width of bins
+     * @param obstacles obstacles to consider
+     */
+    void build(const Position& origin, double range, Angle resolution, const ObstacleCandidates& obstacles);
+
+    /**
+     * Discard mask, e.g. when obstacles are gone
+     */
+    void clear();
+
+    /**
+     * Check if mask has been built
+     */
+    bool empty() const { return mFreeDistance.empty(); }
+
+    /**
+     * Find obstacle occluding a point
+     * @param point target point
+     * @return occluding obstacle or nullptr if point is visible
+     */
+    const std::shared_ptr<EnvironmentModelObstacle>* occluder(const Position& point) const;
+
+private:
+    Position mOrigin;
+    double mBinWidth = 0.0;
+    std::vector<double> mFreeDistance;
+    std::vector<std::shared_ptr<EnvironmentModelObstacle>> mOccluders;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_OCCLUSIONMASK_H_ */
@@ -6,25 +6,82 @@
 
 #include "artery/application/Facilities.h"
 #include "artery/application/Middleware.h"
+#include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/sensor/RsuFovSensor.h"
 #include "artery/networking/PositionProvider.h"
 
+using namespace omnetpp;
+
 namespace artery
 {
 
+namespace
+{
+const simsignal_t obstaclesLoadedSignal = cComponent::registerSignal("EnvironmentModel.obstaclesLoaded");
+} // namespace
+
 void RsuFovSensor::initialize()
 {
     FovSensor::initialize();
     mFovHeading = Angle::from_degree(par("fovHeading"));
+
+    mOcclusionMaskResolution = Angle::from_degree(par("occlusionMaskResolution"));
+    if (mOcclusionMaskResolution.degree() < 0.0) {
+        throw cRuntimeError("occlusion mask resolution must not be negative");
+    } else if (mOcclusionMaskResolution.degree() > 0.0 && mFovConfig.doLineOfSightCheck) {
+        mGlobalEnvironmentModel->subscribe(obstaclesLoadedSignal, this);
+    }
+}
+
+void RsuFovSensor::finish()
+{
+    if (mGlobalEnvironmentModel->isSubscribed(obstaclesLoadedSignal, this)) {
+        mGlobalEnvironmentModel->unsubscribe(obstaclesLoadedSignal, this);
+    }
+    mOcclusionMask.clear();
+    FovSensor::finish();
+}
+
+void RsuFovSensor::receiveSignal(cComponent*, simsignal_t signal, cObject*, cObject*)
+{
+    if (signal == obstaclesLoadedSignal) {
+        buildOcclusionMask();
+    }
 }
 
 SensorDetection RsuFovSensor::createSensorCone() const
 {
     SensorDetection detection;
     detection.sensorOrigin = getFacilities().get_const<PositionProvider>().getCartesianPosition();
-    detection.sensorCone = createSensorArc(mFovConfig, detection.sensorOrigin, mFovHeading);
+    detection.sensorConeBounds = mConeTemplate.place(detection.sensorOrigin, mFovHeading, detection.sensorCone);
     return detection;
 }
 
-} // namespace artery
+void RsuFovSensor::buildOcclusionMask()
+{
+    // obstacles and sensor are static, thus only obstacles within sensor cone are relevant
+    const SensorDetection cone = createSensorCone();
+    ObstacleCandidates obstacles;
+    mGlobalEnvironmentModel->preselectObstacles(PreselectionArea::trusted(cone.sensorCone, cone.sensorConeBounds), obstacles);
+
+    const double range = mFovConfig.fieldOfView.range / boost::units::si::meters;
+    mOcclusionMask.build(cone.sensorOrigin, range, mOcclusionMaskResolution, obstacles);
+    EV_DEBUG << "occlusion mask of " << getSensorName() << " built from " << obstacles.size() << " obstacles\n";
+}
+
+const std::shared_ptr<EnvironmentModelObstacle>* RsuFovSensor::findBlockingObstacle(
+        const Position& origin, const Position& point, const ObstacleCandidates& obstacles) const
+{
+    if (mOcclusionMask.empty()) {
+        return FovSensor::findBlockingObstacle(origin, point, obstacles);
+    } else {
+        return mOcclusionMask.occluder(point);
+    }
+}
 
+bool RsuFovSensor::requiresObstacles() const
+{
+    return mOcclusionMask.empty() && FovSensor::requiresObstacles();
+}
+
+} // namespace artery
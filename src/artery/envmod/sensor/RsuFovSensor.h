@@ -8,17 +8,33 @@
 #define ENVMOD_RSUFOVSENSOR_H_
 
 #include "artery/envmod/sensor/FovSensor.h"
+#include "artery/envmod/sensor/OcclusionMask.h"
+#include <omnetpp/clistener.h>
 
 namespace artery
 {
 
-class RsuFovSensor : public FovSensor
+class RsuFovSensor : public FovSensor, public omnetpp::cListener
 {
+public:
+    SensorDetection createSensorCone() const override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+    bool requiresObstacles() const override;
+
 protected:
     void initialize() override;
-    SensorDetection createSensorCone() const override;
+    void finish() override;
+    const std::shared_ptr<EnvironmentModelObstacle>* findBlockingObstacle(
+            const Position& origin, const Position& point, const ObstacleCandidates& obstacles) const override;
+
+    /**
+     * Precompute occlusion by static obstacles for the stationary sensor
+     */
+    void buildOcclusionMask();
 
     Angle mFovHeading;
+    Angle mOcclusionMaskResolution;
+    OcclusionMask mOcclusionMask;
 };
 
 } // namespace artery
@@ -28,6 +28,22 @@ public:
     virtual const std::string getSensorName() const = 0;
     virtual void setSensorName(const std::string& name) = 0;
     virtual SensorDetection detectObjects() const = 0;
+
+    /**
+     * Interval between two measurements of this sensor
+     *
+     * LocalEnvironmentModel skips measurements until this interval has passed.
+     * @return measurement interval, zero for measurements at every refresh
+     */
+    virtual omnetpp::SimTime getMeasurementInterval() const { return omnetpp::SimTime::ZERO; }
+
+    /**
+     * Notify sensor of its next measurement scheduled by LocalEnvironmentModel
+     *
+     * Sensors may use this to prepare measurements only when they are due.
+     * @param next time of next measurement
+     */
+    virtual void scheduleMeasurement(const omnetpp::SimTime& next) {}
 };
 
 } // namespace artery
@@ -1,25 +1,21 @@
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/Geometry.h"
-#include <boost/geometry/strategies/transform/matrix_transformers.hpp>
-#include <boost/math/constants/constants.hpp>
+#include "artery/envmod/PreselectionArea.h"
 #include <boost/units/cmath.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace artery
 {
 
-std::vector<Position> createSensorArc(const SensorConfigFov& config, const Position& egoPos, const Angle& egoHeading)
+SensorConeTemplate::SensorConeTemplate(const SensorConfigFov& config)
 {
-    namespace gm = boost::geometry;
-    using rotation = gm::strategy::transform::rotate_transformer<gm::degree, double, 2, 2>;
-    using translation = gm::strategy::transform::translate_transformer<double, 2, 2>;
-
     const double openingAngleDeg = config.fieldOfView.angle / boost::units::degree::degrees;
     unsigned segments = std::max(config.numSegments, 1u);
     const double segmentAngle = openingAngleDeg / segments;
     const double sensorPositionDeg = relativeAngle(config.sensorPosition).degree();
-
-    std::vector<Position> points;
+    const double range = config.fieldOfView.range / boost::units::si::meters;
 
     const bool full_circle = config.fieldOfView.angle == 360.0 * boost::units::degree::degree;
     if (full_circle) {
@@ -27,27 +23,53 @@ std::vector<Position> createSensorArc(const SensorConfigFov& config, const Posit
         --segments;
     } else {
         // actual cone: add center point
-        points.push_back(Position {0.0, 0.0});
+        mX.push_back(0.0);
+        mY.push_back(0.0);
     }
 
-    Position sensorBoundary(config.fieldOfView.range / boost::units::si::meters, 0.0);
-    rotation rotateSensorBoundary(egoHeading.degree() - sensorPositionDeg - 0.5 * openingAngleDeg);
-    gm::transform(sensorBoundary, sensorBoundary, rotateSensorBoundary);
-    points.push_back(sensorBoundary);
+    // boundary points rotated clockwise like boost::geometry's rotate_transformer
+    const double startAngleDeg = -sensorPositionDeg - 0.5 * openingAngleDeg;
+    for (unsigned i = 0; i <= segments; ++i) {
+        const double angle = Angle::from_degree(startAngleDeg + i * segmentAngle).radian();
+        mX.push_back(range * std::cos(angle));
+        mY.push_back(-range * std::sin(angle));
+    }
 
-    rotation rotateSegment(segmentAngle);
-    for (unsigned i = 0; i < segments; ++i) {
-        Position segmentPoint;
-        gm::transform(points.back(), segmentPoint, rotateSegment);
-        points.push_back(segmentPoint);
+    // range and opening angle are reported by sensors in more detail
+    if (range > 0.0 && openingAngleDeg <= 360.0) {
+        std::vector<Position> cone;
+        const geometry::Box bounds = place(Position { 0.0, 0.0 }, Angle::from_radian(0.0), cone);
+        PreselectionArea::validate(cone, bounds);
     }
+}
 
-    // translate sensor cone points to car position
-    translation translate(egoPos.x.value(), egoPos.y.value());
-    for (auto& point : points) {
-        gm::transform(point, point, translate);
+geometry::Box SensorConeTemplate::place(const Position& origin, const Angle& heading, std::vector<Position>& cone) const
+{
+    // single 2x3 affine transformation: rotation by heading, then translation to origin
+    const double c = std::cos(heading.radian());
+    const double s = std::sin(heading.radian());
+    const double tx = origin.x.value();
+    const double ty = origin.y.value();
+
+    double minX = tx, minY = ty, maxX = tx, maxY = ty;
+    cone.resize(mX.size());
+    for (std::size_t i = 0; i < mX.size(); ++i) {
+        const double x = c * mX[i] + s * mY[i] + tx;
+        const double y = -s * mX[i] + c * mY[i] + ty;
+        cone[i] = Position { x, y };
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
     }
 
+    return geometry::Box { geometry::Point { minX, minY }, geometry::Point { maxX, maxY } };
+}
+
+std::vector<Position> createSensorArc(const SensorConfigFov& config, const Position& egoPos, const Angle& egoHeading)
+{
+    std::vector<Position> points;
+    SensorConeTemplate(config).place(egoPos, egoHeading, points);
     return points;
 }
 
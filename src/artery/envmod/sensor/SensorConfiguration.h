@@ -10,6 +10,7 @@
 #include "artery/envmod/sensor/FieldOfView.h"
 #include "artery/envmod/sensor/SensorPosition.h"
 #include "artery/utility/Geometry.h"
+#include <string>
 #include <vector>
 
 namespace artery
@@ -33,6 +34,45 @@ struct SensorConfigFov : public SensorConfig
 };
 
 
+/**
+ * Sensor cone in the sensor's local frame, i.e. sensor located at origin with zero heading.
+ *
+ * A cone's shape depends only on the sensor configuration. Hence, it is built once
+ * and just rotated and translated to the sensor's current pose for each measurement.
+ */
+class SensorConeTemplate
+{
+public:
+    SensorConeTemplate() = default;
+
+    /**
+     * Build local cone for given sensor configuration
+     *
+     * Cone validity is checked once here, rotation and translation preserve it.
+     * @param config sensor configuration describing the cone geometry
+     * @throw omnetpp::cRuntimeError if configuration yields an invalid cone
+     */
+    explicit SensorConeTemplate(const SensorConfigFov& config);
+
+    /**
+     * Place cone at sensor pose
+     * @param origin sensor position
+     * @param heading heading of sensor carrier
+     * @param cone receives cone polygon, its storage is reused
+     * @return bounding box of placed cone
+     */
+    geometry::Box place(const Position& origin, const Angle& heading, std::vector<Position>& cone) const;
+
+    /**
+     * Number of cone points
+     */
+    std::size_t size() const { return mX.size(); }
+
+private:
+    std::vector<double> mX;
+    std::vector<double> mY;
+};
+
 /**
  * Creates sensor cone defined by at least 3 points:
  * sensor attachment point, left triangle point, right triangle point.
@@ -21,11 +21,19 @@ struct SensorDetection
 {
     Position sensorOrigin;
     std::vector<Position> sensorCone;
+    geometry::Box sensorConeBounds; // bounding box of sensorCone
     std::list<std::shared_ptr<EnvironmentModelObject>> objects;
     std::list<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
     std::list<Position> visiblePoints; // LOS = one of these points and first of sensorCone
 };
 
+/**
+ * Preselected candidates refer to objects and obstacles stored by the GlobalEnvironmentModel.
+ * They are valid until the model is modified, i.e. at most for the current simulation step.
+ */
+using ObjectCandidates = std::vector<const std::shared_ptr<EnvironmentModelObject>*>;
+using ObstacleCandidates = std::vector<const std::shared_ptr<EnvironmentModelObstacle>*>;
+
 } // namespace artery
 
 #endif /* SENSORDETECTION_H_TLUSLFDM */
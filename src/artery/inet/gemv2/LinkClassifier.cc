@@ -7,7 +7,11 @@
 #include "artery/inet/gemv2/LinkClassifier.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
+#include "traci/BasicNodeManager.h"
+#include <boost/functional/hash.hpp>
 #include <inet/common/ModuleAccess.h>
+#include <cmath>
+#include <tuple>
 
 namespace artery
 {
@@ -16,16 +20,43 @@ namespace gemv2
 
 Define_Module(LinkClassifier)
 
+using namespace omnetpp;
+
 void LinkClassifier::initialize()
 {
     mObstacleIndex = inet::findModuleFromPar<ObstacleIndex>(par("obstacleIndexModule"), this);
     mFoliageIndex = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
     mVehicleIndex = inet::findModuleFromPar<VehicleIndex>(par("vehicleIndexModule"), this);
 
+    mLinkCacheEnabled = par("withLinkCache");
+    if (mLinkCacheEnabled) {
+        cModule* traci = getModuleByPath(par("traciModule"));
+        if (traci) {
+            traci->subscribe(traci::BasicNodeManager::updateNodeSignal, this);
+        } else {
+            throw cRuntimeError("No TraCI module found for signal subscription");
+        }
+    }
+
+    mGridResolution = par("gridCacheResolution");
+    if (mGridResolution < 0.0) {
+        throw cRuntimeError("gridCacheResolution must not be negative");
+    }
+    const int gridCacheCapacity = par("gridCacheCapacity");
+    if (gridCacheCapacity < 0) {
+        throw cRuntimeError("gridCacheCapacity must not be negative");
+    } else if (gridCacheCapacity == 0) {
+        // a cache without capacity would be cleared before every insertion
+        mGridResolution = 0.0;
+    }
+    mGridCacheCapacity = gridCacheCapacity;
+
     WATCH(mCountLOS);
     WATCH(mCountNLOSb);
     WATCH(mCountNLOSf);
     WATCH(mCountNLOSv);
+    WATCH(mCountLinkCacheHits);
+    WATCH(mCountGridCacheHits);
 }
 
 void LinkClassifier::finish()
@@ -34,24 +65,112 @@ void LinkClassifier::finish()
     recordScalar("countNLOSb", mCountNLOSb);
     recordScalar("countNLOSf", mCountNLOSf);
     recordScalar("countNLOSv", mCountNLOSv);
+    recordScalar("countLinkCacheHits", mCountLinkCacheHits);
+    recordScalar("countGridCacheHits", mCountGridCacheHits);
+}
+
+void LinkClassifier::receiveSignal(cComponent*, simsignal_t signal, unsigned long, cObject*)
+{
+    if (signal == traci::BasicNodeManager::updateNodeSignal) {
+        // vehicles have moved, but buildings and foliage are static
+        mLinkCache.clear();
+    }
 }
 
 LinkClass LinkClassifier::classifyLink(const Position& tx, const Position& rx) const
 {
     LinkClass link = LinkClass::LOS;
+    if (mLinkCacheEnabled) {
+        auto key = makeLinkKey(tx.x.value(), tx.y.value(), rx.x.value(), rx.y.value());
+        auto found = mLinkCache.find(key);
+        if (found != mLinkCache.end()) {
+            link = found->second;
+            ++mCountLinkCacheHits;
+        } else {
+            link = classifyUncached(tx, rx);
+            mLinkCache.emplace(key, link);
+        }
+    } else {
+        link = classifyUncached(tx, rx);
+    }
+
+    switch (link) {
+        case LinkClass::LOS:
+            ++mCountLOS;
+            break;
+        case LinkClass::NLOSb:
+            ++mCountNLOSb;
+            break;
+        case LinkClass::NLOSf:
+            ++mCountNLOSf;
+            break;
+        case LinkClass::NLOSv:
+            ++mCountNLOSv;
+            break;
+    }
+    return link;
+}
+
+LinkClass LinkClassifier::classifyUncached(const Position& tx, const Position& rx) const
+{
+    LinkClass link = classifyStatic(tx, rx);
+    if (link == LinkClass::LOS && mVehicleIndex->anyBlockage(tx, rx)) {
+        link = LinkClass::NLOSv;
+    }
+    return link;
+}
+
+LinkClass LinkClassifier::classifyStatic(const Position& tx, const Position& rx) const
+{
+    if (mGridResolution <= 0.0) {
+        return classifyObstacles(tx, rx);
+    }
+
+    auto cell = [this](const Position::value_type& v) {
+        return static_cast<long long>(std::floor(v.value() / mGridResolution));
+    };
+    auto key = makeLinkKey(cell(tx.x), cell(tx.y), cell(rx.x), cell(rx.y));
+    auto found = mGridCache.find(key);
+    if (found != mGridCache.end()) {
+        ++mCountGridCacheHits;
+        return found->second;
+    }
+
+    // start over instead of growing without bounds
+    if (mGridCache.size() >= mGridCacheCapacity) {
+        mGridCache.clear();
+    }
+    LinkClass link = classifyObstacles(tx, rx);
+    mGridCache.emplace(key, link);
+    return link;
+}
+
+LinkClass LinkClassifier::classifyObstacles(const Position& tx, const Position& rx) const
+{
     if (mObstacleIndex->anyBlockage(tx, rx)) {
-        link = LinkClass::NLOSb;
-        ++mCountNLOSb;
+        return LinkClass::NLOSb;
     } else if (mFoliageIndex->anyBlockage(tx, rx)) {
-        link = LinkClass::NLOSf;
-        ++mCountNLOSf;
-    } else if (mVehicleIndex->anyBlockage(tx, rx)) {
-        link = LinkClass::NLOSv;
-        ++mCountNLOSv;
+        return LinkClass::NLOSf;
     } else {
-        ++mCountLOS;
+        return LinkClass::LOS;
     }
-    return link;
+}
+
+template<typename T>
+LinkClassifier::LinkKey<T> LinkClassifier::makeLinkKey(T ax, T ay, T bx, T by)
+{
+    // blockage is symmetric, thus order end points for sharing one entry in both directions
+    if (std::tie(ax, ay) <= std::tie(bx, by)) {
+        return LinkKey<T> {{ ax, ay, bx, by }};
+    } else {
+        return LinkKey<T> {{ bx, by, ax, ay }};
+    }
+}
+
+template<typename T>
+std::size_t LinkClassifier::LinkKeyHash::operator()(const LinkKey<T>& key) const
+{
+    return boost::hash_range(key.begin(), key.end());
 }
 
 } // namespace gemv2
@@ -8,7 +8,11 @@
 #define LINKCLASSIFIER_H_OAXCBN1T
 
 #include "LinkClass.h"
+#include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
+#include <array>
+#include <cstddef>
+#include <unordered_map>
 
 namespace artery
 {
@@ -23,22 +27,57 @@ namespace gemv2
 class ObstacleIndex;
 class VehicleIndex;
 
-class LinkClassifier : public omnetpp::cSimpleModule
+/**
+ * LinkClassifier determines the link class between a transmitter and a receiver.
+ *
+ * Positions do not change within a TraCI step, thus classifications are cached until
+ * the next node update. Optionally, blockage by buildings and foliage is cached across steps
+ * for links between cells of a grid, i.e. any link between the same cells shares one result.
+ */
+class LinkClassifier : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
     void initialize() override;
     void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
     LinkClass classifyLink(const Position& tx, const Position& rx) const;
 
 private:
+    template<typename T>
+    using LinkKey = std::array<T, 4>;
+
+    struct LinkKeyHash
+    {
+        template<typename T>
+        std::size_t operator()(const LinkKey<T>&) const;
+    };
+
+    template<typename T>
+    using LinkCache = std::unordered_map<LinkKey<T>, LinkClass, LinkKeyHash>;
+
+    template<typename T>
+    static LinkKey<T> makeLinkKey(T ax, T ay, T bx, T by);
+
+    LinkClass classifyUncached(const Position& tx, const Position& rx) const;
+    LinkClass classifyStatic(const Position& tx, const Position& rx) const;
+    LinkClass classifyObstacles(const Position& tx, const Position& rx) const;
+
     const ObstacleIndex* mObstacleIndex;
     const ObstacleIndex* mFoliageIndex;
     const VehicleIndex* mVehicleIndex;
 
+    bool mLinkCacheEnabled = false;
+    double mGridResolution = 0.0;
+    std::size_t mGridCacheCapacity = 0;
+    mutable LinkCache<double> mLinkCache;
+    mutable LinkCache<long long> mGridCache;
+
     mutable unsigned mCountLOS = 0;
     mutable unsigned mCountNLOSb = 0;
     mutable unsigned mCountNLOSf = 0;
     mutable unsigned mCountNLOSv = 0;
+    mutable unsigned mCountLinkCacheHits = 0;
+    mutable unsigned mCountGridCacheHits = 0;
 };
 
 } // namespace gemv2
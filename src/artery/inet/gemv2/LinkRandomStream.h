@@ -0,0 +1,68 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_GEMV2_LINKRANDOMSTREAM_H_T4KXW9QE
+#define ARTERY_GEMV2_LINKRANDOMSTREAM_H_T4KXW9QE
+
+#include <cmath>
+#include <cstdint>
+
+namespace artery
+{
+namespace gemv2
+{
+
+/**
+ * LinkRandomStream provides random numbers for a single radio link.
+ *
+ * A stream is fully determined by a seed, drawn once per transmission from the simulation's RNG,
+ * and the link identifier, e.g. the receiver's radio id. Hence, draws are reproducible no matter
+ * in which order or on which thread links are evaluated.
+ */
+class LinkRandomStream
+{
+public:
+    LinkRandomStream(std::uint64_t seed, std::uint64_t link) :
+        mState(seed ^ (link * 0xD1B54A32D192ED03ull))
+    {
+    }
+
+    /**
+     * Draw from uniform distribution
+     * \return value in open interval (0, 1)
+     */
+    double uniform()
+    {
+        return (static_cast<double>(next() >> 11) + 0.5) / 9007199254740992.0; /*< 2^53 */
+    }
+
+    /**
+     * Draw from normal distribution (Box-Muller transform)
+     * \param mean mean of distribution
+     * \param stddev standard deviation of distribution
+     */
+    double normal(double mean, double stddev)
+    {
+        const double radius = std::sqrt(-2.0 * std::log(uniform()));
+        return mean + stddev * radius * std::cos(2.0 * M_PI * uniform());
+    }
+
+private:
+    std::uint64_t next()
+    {
+        // SplitMix64 generator
+        std::uint64_t z = (mState += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t mState;
+};
+
+} // namespace gemv2
+} // namespace artery
+
+#endif /* ARTERY_GEMV2_LINKRANDOMSTREAM_H_T4KXW9QE */
@@ -53,6 +53,46 @@ Position reflectPoint(const Position& p, const PositionSegment& line)
     return q;
 }
 
+Position reflectPoint(const Position& p, const ObstacleIndex::Edge& edge)
+{
+    const double px = p.x.value() - edge.first.x.value();
+    const double py = p.y.value() - edge.first.y.value();
+    return Position {
+        edge.cos2 * px + edge.sin2 * py + edge.first.x.value(),
+        edge.sin2 * px - edge.cos2 * py + edge.first.y.value()
+    };
+}
+
+/**
+ * Intersect an edge with segment pq
+ * \param edge obstacle edge
+ * \param p start point of segment
+ * \param q end point of segment
+ * \param intersection single intersection point (only set if true is returned)
+ * \return true if edge and segment intersect at exactly one point
+ */
+bool intersectEdge(const ObstacleIndex::Edge& edge, const Position& p, const Position& q, Position& intersection)
+{
+    const double rx = q.x.value() - p.x.value();
+    const double ry = q.y.value() - p.y.value();
+    const double denom = edge.dx * ry - edge.dy * rx;
+    if (denom == 0.0) {
+        // parallel or collinear: no single intersection point
+        return false;
+    }
+
+    const double wx = p.x.value() - edge.first.x.value();
+    const double wy = p.y.value() - edge.first.y.value();
+    const double t = (wx * ry - wy * rx) / denom;
+    const double s = (wx * edge.dy - wy * edge.dx) / denom;
+    if (t < 0.0 || t > 1.0 || s < 0.0 || s > 1.0) {
+        return false;
+    }
+
+    intersection = Position { edge.first.x.value() + t * edge.dx, edge.first.y.value() + t * edge.dy };
+    return true;
+}
+
 inet::m getWaveLength(const inet::physicallayer::ITransmission* transmission)
 {
     auto radioMedium = transmission->getTransmitter()->getMedium();
@@ -150,35 +190,26 @@ double NLOSb::computePathLoss(const phy::ITransmission* transmission, const phy:
 std::vector<Position> NLOSb::computeReflectionRaysFromBuildings(const Environment& env) const
 {
     std::vector<Position> rays;
-    std::vector<Position> intersections;
+    Position intersection;
     const double squaredLengthTxRx = squaredLength(env.tx, env.rx);
 
     for (const ObstacleIndex::Obstacle* obstacle : env.obstacles)
     {
-        const PositionRange& outline = obstacle->getOutline();
-        if (outline.size() < 2) continue;
-
-        PositionView view(outline);
-        for (auto a = view.begin(), b = std::next(a); b != view.end(); ++a, ++b)
+        for (const ObstacleIndex::Edge& edge : obstacle->getEdges())
         {
-            PositionSegment segment(*a, *b);
-
-            // calculate mirror point Rx' of Rx w.r.t. segment
-            Position rx_m = reflectPoint(env.rx, segment);
+            // calculate mirror point Rx' of Rx w.r.t. edge
+            const Position rx_m = reflectPoint(env.rx, edge);
 
             // no valid reflection possible if d(Tx, Rx) > d(Tx, Rx')
             if (squaredLengthTxRx > squaredLength(env.tx, rx_m)) {
-                // skip segment because Tx and Rx are on opposite sides of segment
+                // skip edge because Tx and Rx are on opposite sides of edge
                 continue;
             }
 
-            // intersection between ray TxRx' and segment is reflection point
-            PositionSegment ray(env.tx, rx_m);
-            bg::intersection(segment, ray, intersections);
-            if (intersections.size() == 1 && !isRayObstructed(intersections[0], env)) {
-                rays.emplace_back(intersections[0]);
+            // intersection between ray TxRx' and edge is reflection point
+            if (intersectEdge(edge, env.tx, rx_m, intersection) && !isRayObstructed(intersection, env)) {
+                rays.emplace_back(intersection);
             }
-            intersections.clear();
         }
     }
 
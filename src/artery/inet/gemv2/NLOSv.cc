@@ -10,6 +10,7 @@
 #include <inet/common/ModuleAccess.h>
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <vector>
@@ -28,9 +29,10 @@ namespace {
 auto compareDistance = [](const DiffractionObstacle& a, const DiffractionObstacle& b) { return a.d < b.d; };
 auto compareHeight = [](const DiffractionObstacle& a, const DiffractionObstacle& b) { return a.h < b.h; };
 
-using ObstacleIterator = std::list<DiffractionObstacle>::const_iterator;
-ObstacleIterator findMainObstacle(ObstacleIterator, ObstacleIterator);
-ObstacleIterator findSecondaryObstacle(ObstacleIterator, ObstacleIterator);
+using ObstacleList = std::vector<DiffractionObstacle>;
+std::size_t findMainObstacle(const ObstacleList&, std::size_t);
+std::size_t findSecondaryObstacle(const ObstacleList&, std::size_t, std::size_t);
+void sortByDistance(ObstacleList::iterator, ObstacleList::iterator);
 } // namespace
 
 DiffractionObstacle::DiffractionObstacle(meter distTx, meter height) :
@@ -79,28 +81,33 @@ double NLOSv::computeVehiclePathLoss(const Coord& pos_tx, const Coord& pos_rx, m
     DiffractionObstacle Tx { meter(0.0), meter(pos_tx.z) };
     DiffractionObstacle Rx { distTxRx, meter(pos_rx.z) };
 
-    auto vehicles = mVehicleIndex->getObstructingVehicles(Position { pos_tx.x, pos_tx.y }, Position { pos_rx.x, pos_rx.y });
-    std::vector<DiffractionPath> paths;
-    paths.reserve(3);
+    // scratch buffers keep their capacity across calls, i.e. no heap allocations in steady state
+    thread_local VehicleList vehicles;
+    thread_local std::vector<DiffractionPath> paths;
+    thread_local ObstacleList obsTop;
+    thread_local SideObstacles obsSides;
 
-    auto obsTop = buildTopObstacles(vehicles, pos_tx, pos_rx);
+    mVehicleIndex->getObstructingVehicles(Position { pos_tx.x, pos_tx.y }, Position { pos_rx.x, pos_rx.y }, vehicles);
+    paths.clear();
+
+    buildTopObstacles(vehicles, pos_tx, pos_rx, obsTop);
     if (!obsTop.empty()) {
-        obsTop.push_front(Tx);
+        obsTop.insert(obsTop.begin(), Tx);
         obsTop.push_back(Rx);
         paths.push_back(computeMultipleKnifeEdge(obsTop, lambda));
     }
 
     // original GEMV² code uses same Tx and Rx heights for all three paths: we assume zero "height" on side paths
-    auto obsSides = buildSideObstacles(vehicles, pos_tx, pos_rx);
+    buildSideObstacles(vehicles, pos_tx, pos_rx, obsSides);
     Tx.h = meter(0.0);
     Rx.h = meter(0.0);
     if (!obsSides.left.empty()) {
-        obsSides.left.push_front(Tx);
+        obsSides.left.insert(obsSides.left.begin(), Tx);
         obsSides.left.push_back(Rx);
         paths.push_back(computeMultipleKnifeEdge(obsSides.left, lambda));
     }
     if (!obsSides.right.empty()) {
-        obsSides.right.push_front(Tx);
+        obsSides.right.insert(obsSides.right.begin(), Tx);
         obsSides.right.push_back(Rx);
         paths.push_back(computeMultipleKnifeEdge(obsSides.right, lambda));
     }
@@ -118,7 +125,7 @@ m NLOSv::computeRange(mps propagationSpeed, Hz frequency, double loss) const
     return m(NaN);
 }
 
-double NLOSv::computeSimpleKnifeEdge(m heightTx, m heightRx, m heightObs, m distTxRx, m distTxObs, m lambda) const
+void NLOSv::computeKnifeEdges(KnifeEdges& edges, m lambda) const
 {
     // following calculations are similar to equation 29 of ITU-R P.526-13:
     //  v = sqrt(2d/lambda * alpha1 * alpha2)
@@ -130,86 +137,116 @@ double NLOSv::computeSimpleKnifeEdge(m heightTx, m heightRx, m heightObs, m dist
     //  v = sqrt(2d / lambda * h / d1 * h / d2) = sqrt(2) * h / sqrt(lambda * d1 * d2 / d)
     //
     // with d1 = distTxObs, d2 = distRxObs, d = distTxRx,
+    //
+    // Each of the first two loops writes a single plain array so the compiler can vectorise them,
+    // square root and logarithm are left to the final scalar loop.
+
+    const std::size_t n = edges.size();
+    edges.height.resize(n);
+    edges.fresnel.resize(n);
+    edges.loss.resize(n);
+    const double* heightTx = edges.heightTx.data();
+    const double* heightRx = edges.heightRx.data();
+    const double* heightObs = edges.heightObs.data();
+    const double* distTxRx = edges.distTxRx.data();
+    const double* distTxObs = edges.distTxObs.data();
+    double* height = edges.height.data();
+    double* fresnel = edges.fresnel.data();
+    const double l = lambda.get();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        // signed height relative to the line connecting Tx and Rx at obstacle position
+        const double obsHeightTxRxLine = (heightRx[i] - heightTx[i]) / distTxRx[i] * distTxObs[i] + heightTx[i];
+        height[i] = heightObs[i] - obsHeightTxRxLine;
+    }
 
-    // distance between Rx and obstacle
-    const m distRxObs = distTxRx - distTxObs;
-    // signed height relative to the line connecting Tx and Rx at obstacle position
-    const m obsHeightTxRxLine = (heightRx - heightTx) / distTxRx * distTxObs + heightTx;
-    const m h = heightObs - obsHeightTxRxLine;
-    // calculate the Fresnel ray
-    const m r = sqrt(lambda * distTxObs * distRxObs / distTxRx);
-    static const double root_two = sqrt(2.0);
-    const double v = root_two * static_cast<inet::unit>(h / r).get();
-
-    double loss = 0.0;
-    if (v > -0.78) {
-        // approximation of Fresnel-Kirchoff loss given by ITU-R P.526, equation 31 (result in dB):
-        // J(v) = 6.9 + 20 log(sqrt((v - 01)^2 + 1) + v - 0.1)
-        loss = 6.9 + 20.0 * log10(sqrt(squared(v - 0.1) + 1.0) + v - 0.1);
+    for (std::size_t i = 0; i < n; ++i) {
+        // squared Fresnel ray, (distTxRx - distTxObs) is distance between Rx and obstacle
+        fresnel[i] = l * distTxObs[i] * (distTxRx[i] - distTxObs[i]) / distTxRx[i];
     }
 
-    return loss;
+    static const double root_two = sqrt(2.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = root_two * (height[i] / std::sqrt(fresnel[i]));
+        double loss = 0.0;
+        if (v > -0.78) {
+            // approximation of Fresnel-Kirchoff loss given by ITU-R P.526, equation 31 (result in dB):
+            // J(v) = 6.9 + 20 log(sqrt((v - 01)^2 + 1) + v - 0.1)
+            loss = 6.9 + 20.0 * log10(sqrt(squared(v - 0.1) + 1.0) + v - 0.1);
+        }
+        edges.loss[i] = loss;
+    }
 }
 
-DiffractionPath NLOSv::computeMultipleKnifeEdge(const std::list<DiffractionObstacle>& obs, m lambda) const
+DiffractionPath NLOSv::computeMultipleKnifeEdge(const ObstacleList& obs, m lambda) const
 {
     ASSERT(obs.size() > 2);
     DiffractionPath path;
-
-    // determine main and secondary obstacles
-    std::vector<ObstacleIterator> mainObs;
-    mainObs.push_back(obs.begin()); // Tx
-    for (ObstacleIterator it = obs.begin(); it != obs.end();) {
-        it = findMainObstacle(it, obs.end());
-        if (it != obs.end()) {
-            mainObs.push_back(it);
+    thread_local std::vector<std::size_t> mainObs;
+    thread_local std::vector<meter> mainObsDistances;
+    thread_local KnifeEdges edges;
+
+    // determine main obstacles
+    mainObs.clear();
+    mainObs.push_back(0); // Tx
+    for (std::size_t i = 0; i < obs.size();) {
+        i = findMainObstacle(obs, i);
+        if (i < obs.size()) {
+            mainObs.push_back(i);
         }
     }
     // NOTE: Rx is added by loop as last main obstacle
     ASSERT(mainObs.size() <= obs.size());
 
-    struct SecondaryObstacle {
-        SecondaryObstacle(ObstacleIterator tx, ObstacleIterator obs, ObstacleIterator rx) :
-            tx(tx), obstacle(obs), rx(rx) {}
-        ObstacleIterator tx;
-        ObstacleIterator obstacle;
-        ObstacleIterator rx;
-    };
-
-    std::vector<SecondaryObstacle> secObs;
-    std::vector<meter> mainObsDistances;
+    mainObsDistances.clear();
     for (std::size_t i = 0, j = 1; j < mainObs.size(); ++i, ++j) {
-        const meter d = mainObs[j]->d - mainObs[i]->d;
-        path.d += sqrt(squared(d) + squared(mainObs[j]->h - mainObs[i]->h));
+        const meter d = obs[mainObs[j]].d - obs[mainObs[i]].d;
+        path.d += sqrt(squared(d) + squared(obs[mainObs[j]].h - obs[mainObs[i]].h));
         mainObsDistances.push_back(d);
+    }
+
+    // knife-edges of main obstacles come first, followed by those of secondary obstacles
+    edges.clear();
+    for (std::size_t i = 0; i < mainObs.size() - 2; ++i) {
+        const meter distTxObs = mainObsDistances[i];
+        const meter distTxRx = distTxObs + mainObsDistances[i+1];
+        edges.add(obs[mainObs[i]].h, obs[mainObs[i+2]].h, obs[mainObs[i+1]].h, distTxRx, distTxObs);
+    }
+    const std::size_t numMainEdges = edges.size();
 
-        const auto delta = std::distance(mainObs[i], mainObs[j]);
+    for (std::size_t i = 0, j = 1; j < mainObs.size(); ++i, ++j) {
+        const std::size_t delta = mainObs[j] - mainObs[i];
+        std::size_t sec = obs.size();
         if (delta == 2) {
             // single other obstacle between two main obstacles
-            secObs.emplace_back(mainObs[i], std::next(mainObs[i]), mainObs[j]);
+            sec = mainObs[i] + 1;
         } else if (delta > 2) {
-            secObs.emplace_back(mainObs[i], findSecondaryObstacle(mainObs[i], mainObs[j]), mainObs[j]);
+            sec = findSecondaryObstacle(obs, mainObs[i], mainObs[j]);
+        }
+
+        if (sec < obs.size()) {
+            const DiffractionObstacle& tx = obs[mainObs[i]];
+            const DiffractionObstacle& rx = obs[mainObs[j]];
+            edges.add(tx.h, rx.h, obs[sec].h, rx.d - tx.d, obs[sec].d - tx.d);
         }
     }
 
+    computeKnifeEdges(edges, lambda);
+
     // attenuation due to main obstacles
     double attMainObs = 0.0;
-    for (std::size_t i = 0; i < mainObs.size() - 2; ++i) {
-        const meter distTxObs = mainObsDistances[i];
-        const meter distTxRx = distTxObs + mainObsDistances[i+1];
-        attMainObs += computeSimpleKnifeEdge(mainObs[i]->h, mainObs[i+2]->h, mainObs[i+1]->h, distTxRx, distTxObs, lambda);
+    for (std::size_t i = 0; i < numMainEdges; ++i) {
+        attMainObs += edges.loss[i];
     }
 
     // attenuation due to secondary obstacles
     double attSecObs = 0.0;
-    for (const SecondaryObstacle& sec : secObs) {
-        const meter distTxRx = sec.rx->d - sec.tx->d;
-        const meter distTxObs = sec.obstacle->d - sec.tx->d;
-        attSecObs += computeSimpleKnifeEdge(sec.tx->h, sec.rx->h, sec.obstacle->h, distTxRx, distTxObs, lambda);
+    for (std::size_t i = numMainEdges; i < edges.size(); ++i) {
+        attSecObs += edges.loss[i];
     }
 
     // correction factor C (see eq. 46 in ITU-R P.526-13)
-    double C = (mainObs.back()->d - mainObs.front()->d).get(); // distance between Tx and Rx
+    double C = (obs[mainObs.back()].d - obs[mainObs.front()].d).get(); // distance between Tx and Rx
     for (meter d : mainObsDistances) {
         C *= d.get();
     }
@@ -224,9 +261,9 @@ DiffractionPath NLOSv::computeMultipleKnifeEdge(const std::list<DiffractionObsta
     return path;
 }
 
-std::list<DiffractionObstacle> NLOSv::buildTopObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx) const
+void NLOSv::buildTopObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx, ObstacleList& diffTop) const
 {
-    std::list<DiffractionObstacle> diffTop;
+    diffTop.clear();
     const double vx = pos_rx.x - pos_tx.x;
     const double vy = pos_rx.y - pos_tx.y;
 
@@ -238,14 +275,15 @@ std::list<DiffractionObstacle> NLOSv::buildTopObstacles(const VehicleList& vehic
         diffTop.emplace_back(meter(d), meter(vehicle->getHeight()));
     }
 
-    diffTop.sort(compareDistance);
-    return diffTop;
+    sortByDistance(diffTop.begin(), diffTop.end());
 }
 
-NLOSv::SideObstacles NLOSv::buildSideObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx) const
+void NLOSv::buildSideObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx, SideObstacles& sides) const
 {
-    std::list<DiffractionObstacle> diffOnRightSide;
-    std::list<DiffractionObstacle> diffOnLeftSide;
+    ObstacleList& diffOnRightSide = sides.right;
+    ObstacleList& diffOnLeftSide = sides.left;
+    diffOnRightSide.clear();
+    diffOnLeftSide.clear();
 
     //constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
     constexpr double Inf = std::numeric_limits<double>::infinity();
@@ -310,9 +348,29 @@ NLOSv::SideObstacles NLOSv::buildSideObstacles(const VehicleList& vehicles, cons
         }
     }
 
-    diffOnLeftSide.sort(compareDistance);
-    diffOnRightSide.sort(compareDistance);
-    return SideObstacles { std::move(diffOnLeftSide), std::move(diffOnRightSide) };
+    sortByDistance(diffOnLeftSide.begin(), diffOnLeftSide.end());
+    sortByDistance(diffOnRightSide.begin(), diffOnRightSide.end());
+}
+
+void NLOSv::KnifeEdges::clear()
+{
+    heightTx.clear();
+    heightRx.clear();
+    heightObs.clear();
+    distTxRx.clear();
+    distTxObs.clear();
+    height.clear();
+    fresnel.clear();
+    loss.clear();
+}
+
+void NLOSv::KnifeEdges::add(meter hTx, meter hRx, meter hObs, meter dTxRx, meter dTxObs)
+{
+    heightTx.push_back(hTx.get());
+    heightRx.push_back(hRx.get());
+    heightObs.push_back(hObs.get());
+    distTxRx.push_back(dTxRx.get());
+    distTxObs.push_back(dTxObs.get());
 }
 
 double NLOSv::combineDiffractionLoss(const std::vector<DiffractionPath>& paths, m /* lambda */) const
@@ -332,42 +390,51 @@ double NLOSv::combineDiffractionLoss(const std::vector<DiffractionPath>& paths,
 
 namespace {
 
-ObstacleIterator findMainObstacle(ObstacleIterator begin, ObstacleIterator end)
+std::size_t findMainObstacle(const ObstacleList& obs, std::size_t begin)
 {
-    ObstacleIterator mainIterator = end;
+    std::size_t main = obs.size();
     double mainAngle = -std::numeric_limits<double>::infinity();
 
-    if (begin != end) {
-        for (ObstacleIterator it = std::next(begin); it != end; ++it) {
-            double angle = static_cast<inet::unit>((it->h - begin->h) / (it->d - begin->d)).get();
+    if (begin < obs.size()) {
+        for (std::size_t i = begin + 1; i < obs.size(); ++i) {
+            double angle = static_cast<inet::unit>((obs[i].h - obs[begin].h) / (obs[i].d - obs[begin].d)).get();
             if (angle > mainAngle) {
-                mainIterator = it;
+                main = i;
                 mainAngle = angle;
             }
         }
     }
 
-    return mainIterator;
+    return main;
 }
 
-ObstacleIterator findSecondaryObstacle(ObstacleIterator first, ObstacleIterator last)
+std::size_t findSecondaryObstacle(const ObstacleList& obs, std::size_t first, std::size_t last)
 {
-    ASSERT(std::distance(first, last) > 2);
-    ObstacleIterator secIterator = last;
+    ASSERT(last - first > 2);
+    std::size_t sec = last;
     inet::m secHeightGap { std::numeric_limits<double>::infinity() };
 
-    const inet::m distFirstLast = last->d - first->d;
-    const inet::m heightFirstLast = last->h - first->h;
-    const auto offset = first->h * last->d - first->d * last->h;
-    for (ObstacleIterator it = std::next(first); it != last; ++it) {
-        const inet::m heightGap = ((it->d * heightFirstLast + offset) / distFirstLast) - it->h;
+    const inet::m distFirstLast = obs[last].d - obs[first].d;
+    const inet::m heightFirstLast = obs[last].h - obs[first].h;
+    const auto offset = obs[first].h * obs[last].d - obs[first].d * obs[last].h;
+    for (std::size_t i = first + 1; i != last; ++i) {
+        const inet::m heightGap = ((obs[i].d * heightFirstLast + offset) / distFirstLast) - obs[i].h;
         if (heightGap < secHeightGap) {
-            secIterator = it;
+            sec = i;
             secHeightGap = heightGap;
         }
     }
 
-    return secIterator;
+    return sec;
+}
+
+void sortByDistance(ObstacleList::iterator first, ObstacleList::iterator last)
+{
+    // stable insertion sort: few obstacles per link and no temporary buffer unlike std::stable_sort
+    for (auto it = first; it != last; ++it) {
+        auto pos = std::upper_bound(first, it, *it, compareDistance);
+        std::rotate(pos, it, std::next(it));
+    }
 }
 
 } // namespace
@@ -5,7 +5,8 @@
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IPathLoss.h>
 #include <omnetpp/csimplemodule.h>
-#include <list>
+#include <cstddef>
+#include <vector>
 
 namespace artery
 {
@@ -41,18 +42,43 @@ public:
 
 protected:
     using VehicleList = std::vector<const VehicleIndex::Vehicle*>;
-
+    using ObstacleList = std::vector<DiffractionObstacle>;
 
     struct SideObstacles {
-        std::list<DiffractionObstacle> left;
-        std::list<DiffractionObstacle> right;
+        ObstacleList left;
+        ObstacleList right;
+    };
+
+    /**
+     * KnifeEdges holds input and output of simple knife-edge evaluations as flat arrays
+     */
+    struct KnifeEdges {
+        void clear();
+        void add(meter heightTx, meter heightRx, meter heightObs, meter distTxRx, meter distTxObs);
+        std::size_t size() const { return heightObs.size(); }
+
+        std::vector<double> heightTx;
+        std::vector<double> heightRx;
+        std::vector<double> heightObs;
+        std::vector<double> distTxRx;
+        std::vector<double> distTxObs;
+        std::vector<double> height; /*< obstacle height above TxRx line, filled by computeKnifeEdges */
+        std::vector<double> fresnel; /*< squared Fresnel ray, filled by computeKnifeEdges */
+        std::vector<double> loss; /*< loss in dB, filled by computeKnifeEdges */
     };
 
     virtual double computeVehiclePathLoss(const inet::Coord&, const inet::Coord&, inet::m lambda) const;
-    virtual DiffractionPath computeMultipleKnifeEdge(const std::list<DiffractionObstacle>&, inet::m lambda) const;
-    virtual double computeSimpleKnifeEdge(inet::m heightTx, inet::m heightRx, inet::m heightObs, inet::m distTxRx, inet::m distTxObs, inet::m lambda) const;
-    virtual std::list<DiffractionObstacle> buildTopObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx) const;
-    virtual SideObstacles buildSideObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx) const;
+    virtual DiffractionPath computeMultipleKnifeEdge(const ObstacleList&, inet::m lambda) const;
+
+    /**
+     * Compute loss of simple knife-edges for all given obstacles at once
+     * \param edges obstacle heights and distances, losses (dB) are stored there
+     * \param lambda wave length
+     */
+    virtual void computeKnifeEdges(KnifeEdges& edges, inet::m lambda) const;
+
+    virtual void buildTopObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx, ObstacleList&) const;
+    virtual void buildSideObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx, SideObstacles&) const;
     virtual double combineDiffractionLoss(const std::vector<DiffractionPath>&, inet::m lambda) const;
 
     const VehicleIndex* mVehicleIndex;
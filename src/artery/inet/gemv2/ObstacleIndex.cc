@@ -12,6 +12,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/linestring.hpp>
+#include <boost/geometry/views/closeable_view.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/units/cmath.hpp>
@@ -19,6 +20,7 @@
 #include <omnetpp/checkandcast.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
 
 namespace bg = boost::geometry;
 
@@ -189,6 +191,28 @@ ObstacleIndex::Obstacle::Obstacle(std::vector<Position>&& shape) :
     mCentroid(bg::return_centroid<Position>(mOutline)),
     mArea(bg::area(mOutline))
 {
+    // buildings are static: prepare their edges once instead of per reception
+    using View = bg::closeable_view<const std::vector<Position>, bg::closure<std::vector<Position>>::value>::type;
+    View view(mOutline);
+    if (mOutline.size() >= 2) {
+        mEdges.reserve(mOutline.size());
+        for (auto a = view.begin(), b = std::next(a); b != view.end(); ++a, ++b) {
+            if (*a != *b) {
+                mEdges.emplace_back(*a, *b);
+            }
+        }
+    }
+}
+
+ObstacleIndex::Edge::Edge(const Position& a, const Position& b) :
+    first(a), second(b),
+    dx(b.x.value() - a.x.value()), dy(b.y.value() - a.y.value()),
+    length(std::hypot(dx, dy))
+{
+    const double ux = dx / length;
+    const double uy = dy / length;
+    cos2 = ux * ux - uy * uy;
+    sin2 = 2.0 * ux * uy;
 }
 
 } // namespace gemv2
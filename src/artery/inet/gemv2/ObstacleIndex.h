@@ -29,16 +29,34 @@ class Visualizer;
 class ObstacleIndex : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
+    /**
+     * Edge is a segment of an obstacle's outline with attributes precomputed for reflections
+     */
+    struct Edge
+    {
+        Edge(const Position& a, const Position& b);
+
+        Position first; /*< start point */
+        Position second; /*< end point */
+        double dx; /*< x component of direction from start to end point */
+        double dy; /*< y component of direction from start to end point */
+        double length; /*< length of segment */
+        double cos2; /*< cosine of double segment angle, used for mirroring points */
+        double sin2; /*< sine of double segment angle, used for mirroring points */
+    };
+
     class Obstacle
     {
     public:
         Obstacle(std::vector<Position>&& shape);
         const std::vector<Position>& getOutline() const { return mOutline; }
+        const std::vector<Edge>& getEdges() const { return mEdges; }
         double getArea() const { return mArea; }
         const Position& getCentroid() const { return mCentroid; }
 
     private:
         std::vector<Position> mOutline;
+        std::vector<Edge> mEdges;
         Position mCentroid;
         double mArea;
     };
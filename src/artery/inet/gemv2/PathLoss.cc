@@ -5,11 +5,16 @@
  */
 
 #include "artery/inet/gemv2/LinkClassifier.h"
+#include "artery/inet/gemv2/LinkRandomStream.h"
 #include "artery/inet/gemv2/PathLoss.h"
 #include "artery/inet/gemv2/SmallScaleVariation.h"
 #include "artery/utility/Geometry.h"
+#include "artery/utility/WorkerPool.h"
+#include <inet/physicallayer/contract/packetlevel/IRadio.h>
+#include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
 #include <omnetpp/checkandcast.h>
 #include <omnetpp/cexception.h>
+#include <algorithm>
 
 namespace artery
 {
@@ -21,10 +26,36 @@ Define_Module(PathLoss)
 using namespace inet;
 namespace phy = inet::physicallayer;
 
+namespace
+{
+
+const char* getLinkClassName(LinkClass link)
+{
+    switch (link) {
+        case LinkClass::LOS:
+            return "LOS";
+        case LinkClass::NLOSb:
+            return "NLOSb";
+        case LinkClass::NLOSf:
+            return "NLOSf";
+        case LinkClass::NLOSv:
+            return "NLOSv";
+        default:
+            return "invalid";
+    }
+}
+
+} // namespace
+
 PathLoss::PathLoss() :
     m_los(nullptr), m_nlos_b(nullptr), m_nlos_f(nullptr), m_nlos_v(nullptr),
     m_classifier(nullptr), m_small_scale(nullptr),
-    m_range_los(NaN), m_range_nlos_b(NaN), m_range_nlos_f(NaN), m_range_nlos_v(NaN)
+    m_range_los(NaN), m_range_nlos_b(NaN), m_range_nlos_f(NaN), m_range_nlos_v(NaN), m_range_max(NaN),
+    m_batched(false)
+{
+}
+
+PathLoss::~PathLoss()
 {
 }
 
@@ -40,14 +71,134 @@ void PathLoss::initialize()
     m_range_nlos_b = meter(par("rangeNLOSb"));
     m_range_nlos_f = meter(par("rangeNLOSf"));
     m_range_nlos_v = meter(par("rangeNLOSv"));
+    m_range_max = std::max({m_range_los, m_range_nlos_b, m_range_nlos_f, m_range_nlos_v});
+
+    m_batched = par("batched");
+    const int threads = par("threads");
+    if (threads > 1) {
+        if (!m_batched) {
+            throw cRuntimeError("parallel path loss computation requires batched mode");
+        } else if (getSubmodule("visualizer")) {
+            throw cRuntimeError("parallel path loss computation does not support visualization");
+        }
+        m_workers.reset(new WorkerPool(threads));
+    }
+
+    if (m_batched) {
+        cModule* medium = getModuleByPath(par("radioMediumModule"));
+        if (medium) {
+            medium->subscribe(phy::IRadioMedium::radioAddedSignal, this);
+            medium->subscribe(phy::IRadioMedium::radioRemovedSignal, this);
+            medium->subscribe(phy::IRadioMedium::transmissionAddedSignal, this);
+            medium->subscribe(phy::IRadioMedium::transmissionRemovedSignal, this);
+        } else {
+            throw cRuntimeError("No radio medium found for signal subscription");
+        }
+    }
+}
+
+void PathLoss::finish()
+{
+    m_loss_tables.clear();
+    m_workers.reset();
+}
+
+void PathLoss::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
+{
+    Enter_Method_Silent();
+    if (signal == phy::IRadioMedium::transmissionAddedSignal) {
+        computePathLosses(check_and_cast<const phy::ITransmission*>(obj));
+    } else if (signal == phy::IRadioMedium::transmissionRemovedSignal) {
+        m_loss_tables.erase(check_and_cast<const phy::ITransmission*>(obj));
+    } else if (signal == phy::IRadioMedium::radioAddedSignal) {
+        m_radios.push_back(check_and_cast<const phy::IRadio*>(obj));
+    } else if (signal == phy::IRadioMedium::radioRemovedSignal) {
+        auto radio = check_and_cast<const phy::IRadio*>(obj);
+        m_radios.erase(std::remove(m_radios.begin(), m_radios.end(), radio), m_radios.end());
+    }
+}
+
+void PathLoss::computePathLosses(const phy::ITransmission* transmission)
+{
+    const phy::IRadio* transmitter = transmission->getTransmitter();
+    const phy::IRadioMedium* medium = transmitter->getMedium();
+    const inet::Coord tx = transmission->getStartPosition();
+    LossTable& losses = m_loss_tables[transmission];
+    losses.clear();
+
+    // link classification, logging and RNG access are restricted to this thread
+    m_batch.clear();
+    for (const phy::IRadio* receiver : m_radios) {
+        const phy::IArrival* arrival = receiver != transmitter ? medium->getArrival(receiver, transmission) : nullptr;
+        if (!arrival) {
+            continue;
+        }
+
+        const inet::Coord rx = arrival->getStartPosition();
+        if (tx.distance(rx) > m_range_max.get()) {
+            // beyond range of any link class: all signal power is lost
+            losses.emplace(arrival, 0.0);
+            continue;
+        }
+
+        Link link;
+        link.receiver = receiver;
+        link.arrival = arrival;
+        link.link = m_classifier->classifyLink(Position { tx.x, tx.y }, Position { rx.x, rx.y });
+        link.loss = 0.0;
+        EV_DETAIL << getLinkClassName(link.link) << " propagation for " << *transmission << "\n";
+        m_batch.push_back(link);
+    }
+
+    // each link draws from its own stream, thus results do not depend on thread scheduling
+    const std::uint64_t seed = m_small_scale ? m_small_scale->drawStreamSeed() : 0;
+    auto compute = [this, transmission, seed](std::size_t i) {
+        Link& link = m_batch[i];
+        LinkRandomStream stream(seed, link.receiver->getId());
+        link.loss = computeLinkPathLoss(transmission, link.arrival, link.link, &stream, &link.densities);
+    };
+
+    if (m_workers) {
+        m_workers->run(m_batch.size(), compute);
+    } else {
+        for (std::size_t i = 0; i < m_batch.size(); ++i) {
+            compute(i);
+        }
+    }
+
+    for (const Link& link : m_batch) {
+        if (m_small_scale) {
+            m_small_scale->reportDensities(link.densities);
+        }
+        losses.emplace(link.arrival, link.loss);
+    }
 }
 
 double PathLoss::computePathLoss(const phy::ITransmission* transmission, const phy::IArrival* arrival) const
 {
+    if (m_batched) {
+        auto table = m_loss_tables.find(transmission);
+        if (table != m_loss_tables.end()) {
+            auto found = table->second.find(arrival);
+            if (found != table->second.end()) {
+                return found->second;
+            }
+        }
+    }
+
     inet::Coord tx = transmission->getStartPosition();
     inet::Coord rx = arrival->getStartPosition();
-
     LinkClass link = m_classifier->classifyLink(Position { tx.x, tx.y }, Position { rx.x, rx.y });
+    EV_DETAIL << getLinkClassName(link) << " propagation for " << *transmission << "\n";
+    return computeLinkPathLoss(transmission, arrival, link, nullptr, nullptr);
+}
+
+double PathLoss::computeLinkPathLoss(const phy::ITransmission* transmission, const phy::IArrival* arrival, LinkClass link,
+        LinkRandomStream* stream, SmallScaleVariation::Densities* densities) const
+{
+    inet::Coord tx = transmission->getStartPosition();
+    inet::Coord rx = arrival->getStartPosition();
+
     IPathLoss* model = nullptr;
     meter range { 0.0 };
     switch (link)
@@ -55,22 +206,18 @@ double PathLoss::computePathLoss(const phy::ITransmission* transmission, const p
         case LinkClass::LOS:
             model = m_los;
             range = m_range_los;
-            EV_DETAIL << "LOS propagation for " << *transmission << "\n";
             break;
         case LinkClass::NLOSb:
             model = m_nlos_b;
             range = m_range_nlos_b;
-            EV_DETAIL << "NLOSb propagation for " << *transmission << "\n";
             break;
         case LinkClass::NLOSf:
             model = m_nlos_f;
             range = m_range_nlos_f;
-            EV_DETAIL << "NLOSf propagation for " << *transmission << "\n";
             break;
         case LinkClass::NLOSv:
             model = m_nlos_v;
             range = m_range_nlos_v;
-            EV_DETAIL << "NLOSv propagation for " << *transmission << "\n";
             break;
         default:
             throw cRuntimeError("invalid link classification");
@@ -83,7 +230,13 @@ double PathLoss::computePathLoss(const phy::ITransmission* transmission, const p
 
     double loss = model->computePathLoss(transmission, arrival);
     if (m_small_scale) {
-        loss *= m_small_scale->computeVariation(Position { tx.x, tx.y }, Position { rx.x, rx.y }, range, link);
+        const Position a { tx.x, tx.y };
+        const Position b { rx.x, rx.y };
+        if (stream && densities) {
+            loss *= m_small_scale->computeVariation(a, b, range, link, *stream, *densities);
+        } else {
+            loss *= m_small_scale->computeVariation(a, b, range, link);
+        }
     }
     return loss;
 }
@@ -7,34 +7,85 @@
 #ifndef PATHLOSS_H_ZABKB47G
 #define PATHLOSS_H_ZABKB47G
 
+#include "artery/inet/gemv2/LinkClass.h"
+#include "artery/inet/gemv2/SmallScaleVariation.h"
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IPathLoss.h>
+#include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace inet { namespace physicallayer { class IRadio; } }
 
 namespace artery
 {
+
+// forward declaration
+class WorkerPool;
+
 namespace gemv2
 {
 
 // forward declarations
 class LinkClassifier;
-class SmallScaleVariation;
+class LinkRandomStream;
 
-class PathLoss : public omnetpp::cSimpleModule, public inet::physicallayer::IPathLoss
+/**
+ * GEMV2 path loss model
+ *
+ * In batched mode, losses of all receivers are computed as soon as a transmission is added
+ * to the radio medium, optionally on several threads, and served from a per-transmission table
+ * when INET evaluates receptions later on.
+ */
+class PathLoss : public omnetpp::cSimpleModule, public omnetpp::cListener, public inet::physicallayer::IPathLoss
 {
 public:
     PathLoss();
+    ~PathLoss();
 
     // OMNeT++ simple module
     void initialize() override;
+    void finish() override;
+
+    // OMNeT++ listener
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
     // INET IPathLoss interface
     double computePathLoss(const inet::physicallayer::ITransmission*, const inet::physicallayer::IArrival*) const override;
     double computePathLoss(inet::mps, inet::Hz, inet::m) const override;
     inet::m computeRange(inet::mps, inet::Hz, double loss) const override;
 
+    /**
+     * Compute losses of all receivers of a transmission and store them for later lookup
+     * \param transmission transmission just added to radio medium
+     */
+    void computePathLosses(const inet::physicallayer::ITransmission* transmission);
+
 private:
     using meter = inet::m;
+    using LossTable = std::unordered_map<const inet::physicallayer::IArrival*, double>;
+
+    /**
+     * Link is a receiver's arrival of a transmission in a batch
+     */
+    struct Link
+    {
+        const inet::physicallayer::IRadio* receiver;
+        const inet::physicallayer::IArrival* arrival;
+        LinkClass link;
+        SmallScaleVariation::Densities densities;
+        double loss;
+    };
+
+    /**
+     * Compute loss of a classified link
+     * \param stream random stream of link for small scale variation, uses module's RNG if nullptr
+     * \param densities densities observed by small scale variation (only with stream)
+     */
+    double computeLinkPathLoss(const inet::physicallayer::ITransmission*, const inet::physicallayer::IArrival*, LinkClass,
+            LinkRandomStream* stream, SmallScaleVariation::Densities* densities) const;
 
     inet::physicallayer::IPathLoss* m_los;
     inet::physicallayer::IPathLoss* m_nlos_b;
@@ -46,6 +97,12 @@ private:
     meter m_range_nlos_b;
     meter m_range_nlos_f;
     meter m_range_nlos_v;
+    meter m_range_max;
+    std::vector<const inet::physicallayer::IRadio*> m_radios;
+    std::unordered_map<const inet::physicallayer::ITransmission*, LossTable> m_loss_tables;
+    std::vector<Link> m_batch;
+    std::unique_ptr<WorkerPool> m_workers;
+    bool m_batched;
 };
 
 } // namespace gemv2
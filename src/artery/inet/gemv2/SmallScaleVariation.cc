@@ -4,6 +4,7 @@
 * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
 */
 
+#include <artery/inet/gemv2/LinkRandomStream.h>
 #include <artery/inet/gemv2/Math.h>
 #include <artery/inet/gemv2/ObstacleIndex.h>
 #include <artery/inet/gemv2/SmallScaleVariation.h>
@@ -66,7 +67,48 @@ double SmallScaleVariation::computeVariation(const Position& a, const Position&
 {
     double minDev = 0.0;
     double maxDev = 0.0;
+    getDeviationBounds(link, minDev, maxDev);
+    return computeVariation(a, b, range, minDev, maxDev);
+}
+
+double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, double minDev, double maxDev) const
+{
+    Densities densities;
+    const double deviation = computeDeviation(a, b, range, minDev, maxDev, densities);
+    reportDensities(densities);
+    return inet::math::dB2fraction(normal(0.0, deviation));
+}
 
+double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, LinkClass link,
+        LinkRandomStream& stream, Densities& densities) const
+{
+    double minDev = 0.0;
+    double maxDev = 0.0;
+    getDeviationBounds(link, minDev, maxDev);
+    const double deviation = computeDeviation(a, b, range, minDev, maxDev, densities);
+    return inet::math::dB2fraction(stream.normal(0.0, deviation));
+}
+
+void SmallScaleVariation::reportDensities(const Densities& densities) const
+{
+    if (densities.vehicles > mMaxObservedVehicleDensity) {
+        mMaxObservedVehicleDensity = densities.vehicles;
+    }
+    if (densities.obstacles > mMaxObservedObstacleDensity) {
+        mMaxObservedObstacleDensity = densities.obstacles;
+    }
+}
+
+std::uint64_t SmallScaleVariation::drawStreamSeed() const
+{
+    omnetpp::cRNG* rng = getRNG(0);
+    const std::uint64_t high = rng->intRand();
+    const std::uint64_t low = rng->intRand();
+    return high << 32 | low;
+}
+
+void SmallScaleVariation::getDeviationBounds(LinkClass link, double& minDev, double& maxDev) const
+{
     switch (link) {
         case LinkClass::LOS:
             minDev = mMinStdDevLOS;
@@ -88,11 +130,9 @@ double SmallScaleVariation::computeVariation(const Position& a, const Position&
             EV_ERROR << "Unknown link class, falling back to zero deviation\n";
             break;
     }
-
-    return computeVariation(a, b, range, minDev, maxDev);
 }
 
-double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, double minDev, double maxDev) const
+double SmallScaleVariation::computeDeviation(const Position& a, const Position& b, m range, double minDev, double maxDev, Densities& densities) const
 {
     using Obstacle = ObstacleIndex::Obstacle;
     using Vehicle = VehicleIndex::Vehicle;
@@ -101,9 +141,7 @@ double SmallScaleVariation::computeVariation(const Position& a, const Position&
 
     // Calculate relative vehicle density: number of vehicles divided by squared effective range
     const double relVehDensity = vehicles.size() / squared(range.get());
-    if (relVehDensity > mMaxObservedVehicleDensity) {
-        mMaxObservedVehicleDensity = relVehDensity;
-    }
+    densities.vehicles = relVehDensity;
 
     // Calculate relative obstacle density: area covered by obstacles divided by squared range
     const double obsTotalArea = std::accumulate(obstacles.begin(), obstacles.end(), 0.0,
@@ -111,15 +149,12 @@ double SmallScaleVariation::computeVariation(const Position& a, const Position&
                 return accu + obs->getArea();
             });
     const double relObsDensity = obsTotalArea / squared(range.get());
-    if (relObsDensity > mMaxObservedObstacleDensity) {
-        mMaxObservedObstacleDensity = relObsDensity;
-    }
+    densities.obstacles = relObsDensity;
 
     // Calculate the vehicle density coefficient and static density coefficient
     const double vehDensityCoeff = std::min(1.0, sqrt(relVehDensity / mMaxVehicleDensity));
     const double obsDensityCoeff = std::min(1.0, sqrt(relObsDensity / mMaxObstacleDensity));
-    const double deviation = minDev + 0.5 * (maxDev - minDev) * (vehDensityCoeff + obsDensityCoeff);
-    return inet::math::dB2fraction(normal(0.0, deviation));
+    return minDev + 0.5 * (maxDev - minDev) * (vehDensityCoeff + obsDensityCoeff);
 }
 
 } // namespace gemv2
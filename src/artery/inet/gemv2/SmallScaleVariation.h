@@ -10,17 +10,20 @@
 #include "artery/inet/gemv2/LinkClass.h"
 #include "inet/common/Units.h"
 #include <omnetpp/csimplemodule.h>
+#include <cstdint>
+#include <limits>
 
+namespace artery
+{
 
 // forward declaration
 class Position;
 
-namespace artery
-{
 namespace gemv2
 {
 
 // forward declarations
+class LinkRandomStream;
 class ObstacleIndex;
 class VehicleIndex;
 
@@ -29,13 +32,47 @@ class SmallScaleVariation : public omnetpp::cSimpleModule
 public:
    using m = inet::units::values::m;
 
+   /**
+    * Densities observed around a link, negative infinity if none has been observed
+    */
+   struct Densities
+   {
+       double vehicles = -std::numeric_limits<double>::infinity();
+       double obstacles = -std::numeric_limits<double>::infinity();
+   };
+
    void initialize() override;
    void finish() override;
 
    double computeVariation(const Position& a, const Position& b, m range, LinkClass link) const;
    double computeVariation(const Position& a, const Position& b, m range, double minSD, double maxSD) const;
 
+   /**
+    * Compute variation of a link without accessing the simulation kernel.
+    * This method may be called concurrently for distinct links.
+    *
+    * \param stream random stream of this link
+    * \param densities densities observed around link, report them via reportDensities later
+    */
+   double computeVariation(const Position& a, const Position& b, m range, LinkClass link,
+           LinkRandomStream& stream, Densities& densities) const;
+
+   /**
+    * Update maximum observed densities
+    * \param densities densities observed around a link
+    */
+   void reportDensities(const Densities& densities) const;
+
+   /**
+    * Draw seed for random streams of all links of a transmission from this module's RNG
+    * \return stream seed
+    */
+   std::uint64_t drawStreamSeed() const;
+
 private:
+   void getDeviationBounds(LinkClass link, double& minSD, double& maxSD) const;
+   double computeDeviation(const Position& a, const Position& b, m range, double minSD, double maxSD, Densities&) const;
+
    const ObstacleIndex* mObstacleIndex;
    const VehicleIndex* mVehicleIndex;
 
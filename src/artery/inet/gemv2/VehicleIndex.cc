@@ -62,11 +62,14 @@ void VehicleIndex::receiveSignal(cComponent* source, simsignal_t signal, unsigne
     if (signal == traci::BasicNodeManager::updateNodeSignal) {
         using Indexable = typename RtreeValue::first_type;
         using Iterator = typename RtreeValue::second_type;
-        mVehicleRtree.clear();
+        // almost all vehicles move per step: bulk loading beats R* insertion and packs the tree tighter
+        mRtreeValues.clear();
+        mRtreeValues.reserve(mVehicles.size());
         for (Iterator it = mVehicles.begin(); it != mVehicles.end(); ++it) {
             const Vehicle& vehicle = it->second;
-            mVehicleRtree.insert(RtreeValue { bg::return_envelope<Indexable>(vehicle.getOutline()), it });
+            mRtreeValues.emplace_back(bg::return_envelope<Indexable>(vehicle.getOutline()), it);
         }
+        mVehicleRtree = Rtree(mRtreeValues.begin(), mRtreeValues.end());
         mRtreeTainted = false;
         if (mVisualizer) {
             mVisualizer->drawVehicles(this);
@@ -128,8 +131,15 @@ bool VehicleIndex::anyBlockage(const Position& a, const Position& b, double heig
 std::vector<const VehicleIndex::Vehicle*>
 VehicleIndex::getObstructingVehicles(const Position& a, const Position& b) const
 {
-    ASSERT(!mRtreeTainted);
     std::vector<const Vehicle*> result;
+    getObstructingVehicles(a, b, result);
+    return result;
+}
+
+void VehicleIndex::getObstructingVehicles(const Position& a, const Position& b, std::vector<const Vehicle*>& result) const
+{
+    ASSERT(!mRtreeTainted);
+    result.clear();
     const LineOfSight los { a, b };
     auto rtree_intersect = bg::index::intersects(los);
     for (auto it = mVehicleRtree.qbegin(rtree_intersect); it != mVehicleRtree.qend(); ++it) {
@@ -138,7 +148,6 @@ VehicleIndex::getObstructingVehicles(const Position& a, const Position& b) const
             result.push_back(&vehicle);
         }
     }
-    return result;
 }
 
 VehicleIndex::Vehicle::Vehicle(const traci::API& api, const std::string& id, double margin) :
@@ -172,16 +181,18 @@ void VehicleIndex::Vehicle::createLocalOutline(double width, double length, doub
 void VehicleIndex::Vehicle::calculateWorldOutline()
 {
     using namespace boost::geometry::strategy::transform;
-    std::vector<Position> tmp;
-    mWorldOutline.clear();
-
     rotate_transformer<boost::geometry::radian, double, 2, 2> rot(mHeading.radian());
     translate_transformer<double, 2, 2> mov(mPosition.x.value(), mPosition.y.value());
-    boost::geometry::transform(mLocalOutline, tmp, rot);
-    boost::geometry::transform(tmp, mWorldOutline, mov);
-    tmp.resize(1);
-    boost::geometry::transform(mLocalMidpoint, tmp.front(), rot);
-    boost::geometry::transform(tmp.front(), mWorldMidpoint, mov);
+
+    // transform point-wise in place, outline keeps its capacity across updates
+    Position rotated;
+    mWorldOutline.resize(mLocalOutline.size());
+    for (std::size_t i = 0; i < mLocalOutline.size(); ++i) {
+        boost::geometry::transform(mLocalOutline[i], rotated, rot);
+        boost::geometry::transform(rotated, mWorldOutline[i], mov);
+    }
+    boost::geometry::transform(mLocalMidpoint, rotated, rot);
+    boost::geometry::transform(rotated, mWorldMidpoint, mov);
 
     ASSERT(mWorldOutline.size() == mLocalOutline.size());
     ASSERT(bg::is_valid(mWorldOutline));
@@ -72,6 +72,14 @@ public:
      */
     std::vector<const Vehicle*> getObstructingVehicles(const Position& a, const Position& b) const;
 
+    /**
+     * Get all vehicles obstructing the line of sight between given points
+     * \param a position a, e.g. transmitter
+     * \param b position b, e.g. receiver
+     * \param result cleared and filled with pointers to obstructing vehicles (capacity is reused)
+     */
+    void getObstructingVehicles(const Position& a, const Position& b, std::vector<const Vehicle*>& result) const;
+
     /**
      * Get vehicles with their center point being within the defined ellipse.
      *
@@ -105,6 +113,7 @@ private:
 
     VehicleMap mVehicles;
     Rtree mVehicleRtree;
+    std::vector<RtreeValue> mRtreeValues;
     bool mRtreeTainted = false;
     Visualizer* mVisualizer = nullptr;
     double mVehicleMargin = 0.0;
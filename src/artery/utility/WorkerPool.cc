@@ -0,0 +1,100 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/WorkerPool.h"
+
+namespace artery
+{
+
+WorkerPool::WorkerPool(unsigned threads) : mNext(0)
+{
+    for (unsigned i = 1; i < threads; ++i) {
+        mWorkers.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mStartCondition.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(std::size_t count, const Task& task)
+{
+    if (count == 0) {
+        return;
+    } else if (mWorkers.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mCount = count;
+        mNext = 0;
+        mBusy = mWorkers.size();
+        mException = nullptr;
+        ++mGeneration;
+    }
+    mStartCondition.notify_all();
+
+    process();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mBusy == 0; });
+    mTask = nullptr;
+    if (mException) {
+        std::rethrow_exception(mException);
+    }
+}
+
+void WorkerPool::work()
+{
+    unsigned long generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStartCondition.wait(lock, [this, generation] { return mStop || mGeneration != generation; });
+            if (mStop) {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        process();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mBusy == 0) {
+            mDoneCondition.notify_one();
+        }
+    }
+}
+
+void WorkerPool::process()
+{
+    for (std::size_t i = mNext++; i < mCount; i = mNext++) {
+        try {
+            (*mTask)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mException) {
+                mException = std::current_exception();
+            }
+            // skip remaining tasks
+            mNext = mCount;
+        }
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,76 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_WORKERPOOL_H_QF6ZLN2D
+#define ARTERY_WORKERPOOL_H_QF6ZLN2D
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * WorkerPool runs independent tasks on a fixed set of worker threads.
+ *
+ * Threads are created once and kept idle between runs.
+ * Tasks must not access OMNeT++ simulation kernel facilities (e.g. emit signals or schedule events).
+ */
+class WorkerPool
+{
+public:
+    using Task = std::function<void(std::size_t)>;
+
+    /**
+     * \param threads number of threads processing tasks including the calling thread
+     */
+    explicit WorkerPool(unsigned threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Invoke task for each index in [0, count) and wait until all invocations have finished.
+     *
+     * The calling thread takes part in processing.
+     * The first exception thrown by any task invocation is re-thrown in the calling thread.
+     *
+     * \param count number of task invocations
+     * \param task function invoked with index
+     */
+    void run(std::size_t count, const Task& task);
+
+    /**
+     * Number of threads processing tasks including the calling thread
+     */
+    unsigned size() const { return mWorkers.size() + 1; }
+
+private:
+    void work();
+    void process();
+
+    std::vector<std::thread> mWorkers;
+    std::mutex mMutex;
+    std::condition_variable mStartCondition;
+    std::condition_variable mDoneCondition;
+    const Task* mTask = nullptr;
+    std::size_t mCount = 0;
+    std::atomic<std::size_t> mNext;
+    unsigned mBusy = 0;
+    unsigned long mGeneration = 0;
+    bool mStop = false;
+    std::exception_ptr mException;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_WORKERPOOL_H_QF6ZLN2D */
@@ -1,10 +1,44 @@
 #include "traci/API.h"
 #include "traci/Launcher.h"
+#include "traci/SubscriptionRecords.h"
+#include <omnetpp/clog.h>
 #include <thread>
 
 namespace traci
 {
 
+namespace
+{
+
+bool isSetCommand(int command)
+{
+    return (command >= libsumo::CMD_SET_INDUCTIONLOOP_VARIABLE && command <= libsumo::CMD_SET_BUSSTOP_VARIABLE) ||
+        (command >= libsumo::CMD_SET_PARKINGAREA_VARIABLE && command <= libsumo::CMD_SET_OVERHEADWIRE_VARIABLE) ||
+        command == libsumo::CMD_SET_FLOW;
+}
+
+[[noreturn]] void throwNotEmbedded(int command)
+{
+    throw libsumo::TraCIException("TraCI command " + std::to_string(command) + " is not supported with embedded SUMO");
+}
+
+} // namespace
+
+API::API()
+#ifdef WITH_LIBSUMO
+    : person(*this), polygon(*this), simulation(*this), vehicle(*this), vehicletype(*this)
+#endif
+{
+#ifdef WITH_LIBSUMO
+    // subscription results received via TraCI socket are stored by dispatching scopes
+    myDomains[libsumo::RESPONSE_SUBSCRIBE_PERSON_VARIABLE] = &person;
+    myDomains[libsumo::RESPONSE_SUBSCRIBE_POLYGON_VARIABLE] = &polygon;
+    myDomains[libsumo::RESPONSE_SUBSCRIBE_SIM_VARIABLE] = &simulation;
+    myDomains[libsumo::RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE] = &vehicle;
+    myDomains[libsumo::RESPONSE_SUBSCRIBE_VEHICLETYPE_VARIABLE] = &vehicletype;
+#endif
+}
+
 TraCIGeoPosition API::convertGeo(const TraCIPosition& pos) const
 {
     libsumo::TraCIPosition result = simulation.convertGeo(pos.x, pos.y, false);
@@ -19,8 +53,160 @@ TraCIPosition API::convert2D(const TraCIGeoPosition& pos) const
     return simulation.convertGeo(pos.longitude, pos.latitude, true);
 }
 
+void API::simulationStep(double time)
+{
+#ifdef WITH_LIBSUMO
+    if (m_embedded) {
+        stepEmbedded(time);
+        return;
+    }
+#endif
+
+    // same as TraCIAPI::simulationStep but response storage is reused and records bypass generic results
+    send_commandSimulationStep(time);
+    check_resultState(m_step_response, libsumo::CMD_SIMSTEP);
+    decodeStep();
+}
+
+void API::requestSimulationStep(double time)
+{
+    if (m_step_requested) {
+        throw libsumo::TraCIException("simulation step requested while previous step is still pending");
+    }
+#ifdef WITH_LIBSUMO
+    if (m_embedded) {
+        // libsumo is not thread-safe, step is performed synchronously on completion
+        m_step_time = time;
+        m_step_requested = true;
+        return;
+    }
+#endif
+
+    send_commandSimulationStep(time);
+    m_step_requested = true;
+}
+
+void API::completeSimulationStep()
+{
+    if (!m_step_requested) {
+        throw libsumo::TraCIException("no simulation step has been requested");
+    }
+    m_step_requested = false;
+
+#ifdef WITH_LIBSUMO
+    if (m_embedded) {
+        stepEmbedded(m_step_time);
+        return;
+    }
+#endif
+
+    // SUMO answers in order of requests: step response precedes acknowledgements of deferred set commands
+    TraCIAPI::check_resultState(m_step_response, libsumo::CMD_SIMSTEP);
+    receiveDeferredAcknowledgements();
+    decodeStep();
+}
+
+void API::check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) const
+{
+    if (m_step_requested) {
+        // command has been sent already, its response follows the step response and is read on completion
+        m_deferred_acks.push_back(command);
+        if (isSetCommand(command) && !acknowledgement) {
+            // caller does not evaluate the response of set commands
+            return;
+        }
+        throw libsumo::TraCIException("TraCI command " + std::to_string(command) +
+                " cannot be answered while a pipelined simulation step is pending, subscribe to its variables instead");
+    }
+
+    TraCIAPI::check_resultState(inMsg, command, ignoreCommandId, acknowledgement);
+}
+
+bool API::processGet(int command, int expectedType, bool ignoreCommandId)
+{
+    // calls not dispatched to libsumo would silently return invalid values without a socket
+    if (m_embedded) {
+        throwNotEmbedded(command);
+    }
+    return TraCIAPI::processGet(command, expectedType, ignoreCommandId);
+}
+
+bool API::processSet(int command)
+{
+    if (m_embedded) {
+        throwNotEmbedded(command);
+    }
+    return TraCIAPI::processSet(command);
+}
+
+void API::receiveDeferredAcknowledgements()
+{
+    tcpip::Storage inMsg;
+    for (int command : m_deferred_acks) {
+        try {
+            TraCIAPI::check_resultState(inMsg, command);
+        } catch (libsumo::TraCIException& e) {
+            // object may have vanished during the pending step, e.g. an arrived vehicle
+            if (isSetCommand(command)) {
+                EV_STATICCONTEXT
+                EV_WARN << "deferred TraCI command failed: " << e.what() << "\n";
+            }
+        }
+    }
+    m_deferred_acks.clear();
+}
+
+void API::decodeStep()
+{
+    for (auto& domain : myDomains) {
+        domain.second->clearSubscriptionResults();
+    }
+    for (auto& records : m_records) {
+        records.second->beginStep();
+    }
+
+    int numSubs = m_step_response.readInt();
+    while (numSubs > 0) {
+        const int cmdId = check_commandGetResult(m_step_response, 0, -1, true);
+        if (cmdId >= libsumo::RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE && cmdId <= libsumo::RESPONSE_SUBSCRIBE_PERSON_VARIABLE) {
+            auto records = m_records.find(cmdId);
+            if (records != m_records.end()) {
+                records->second->decode(m_step_response);
+            } else {
+                readVariableSubscription(cmdId, m_step_response);
+            }
+        } else {
+            auto records = m_records.find(cmdId);
+            if (records != m_records.end()) {
+                records->second->decodeContext(m_step_response);
+            } else {
+                readContextSubscription(cmdId + 0x50, m_step_response);
+            }
+        }
+        numSubs--;
+    }
+}
+
+void API::setSubscriptionRecords(int response, SubscriptionRecords* records)
+{
+    if (records) {
+        m_records[response] = records;
+    } else {
+        m_records.erase(response);
+    }
+}
+
 void API::connect(const ServerEndpoint& endpoint)
 {
+    if (endpoint.embedded) {
+#ifdef WITH_LIBSUMO
+        m_embedded = true;
+        return;
+#else
+        throw libsumo::TraCIException("embedded SUMO requested but TraCI API has been built without libsumo");
+#endif
+    }
+
     const unsigned max_tries = endpoint.retry ? 10 : 0;
     unsigned tries = 0;
     auto sleep = std::chrono::milliseconds(500);
@@ -8,24 +8,205 @@
 #include "traci/Position.h"
 #include "traci/Time.h"
 #include <omnetpp/simtime.h>
+#include <map>
+#include <vector>
 
 namespace traci
 {
 
 class ServerEndpoint;
+class SubscriptionRecords;
 
 class API : public TraCIAPI
 {
 public:
     using Version = std::pair<int, std::string>;
 
+    API();
+
     TraCIGeoPosition convertGeo(const TraCIPosition&) const;
     TraCIPosition convert2D(const TraCIGeoPosition&) const;
 
     void connect(const ServerEndpoint&);
+
+    /**
+     * Check if SUMO runs embedded in this process via libsumo
+     * \return true if calls bypass the TraCI socket
+     */
+    bool isEmbedded() const { return m_embedded; }
+
+    /**
+     * Perform a simulation step and decode its subscription responses
+     * \param time target time, 0 for a single step
+     */
+    void simulationStep(double time = 0);
+
+    /**
+     * Request a simulation step without waiting for its response.
+     *
+     * SUMO computes the step while the caller continues.
+     * Set commands issued meanwhile are sent immediately, but SUMO processes them after the pending step,
+     * i.e. they take effect one step later than without pipelining.
+     * Their acknowledgements are read by completeSimulationStep().
+     * Any other command, e.g. a get command, is refused by an exception until the step has been completed.
+     *
+     * \param time target time, 0 for a single step
+     */
+    void requestSimulationStep(double time = 0);
+
+    /**
+     * Receive the response of a step requested by requestSimulationStep() and decode its subscription responses
+     */
+    void completeSimulationStep();
+
+    /**
+     * Check if a requested step has not been completed yet
+     * \return true if completeSimulationStep() is outstanding
+     */
+    bool isStepPending() const { return m_step_requested; }
+
+    /**
+     * Decode variable or context subscription responses of a domain into records instead of generic results.
+     * Scope's getSubscriptionResults() or getContextSubscriptionResults() yields no results for such a domain.
+     * Records are not used if SUMO is embedded.
+     *
+     * \param response response identifier, e.g. libsumo::RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE
+     *        or libsumo::RESPONSE_SUBSCRIBE_POI_CONTEXT
+     * \param records decoded responses are stored there, nullptr restores generic results
+     */
+    void setSubscriptionRecords(int response, SubscriptionRecords* records);
+
+#ifdef WITH_LIBSUMO
+    /*
+     * Following scopes dispatch to libsumo if SUMO is embedded and to the TraCI socket otherwise.
+     * Only those calls used by Artery are dispatched, any other call still requires a TraCI socket
+     * and raises a TraCIException if SUMO is embedded.
+     */
+    class PersonScope : public TraCIAPI::PersonScope
+    {
+    public:
+        using TraCIAPI::PersonScope::PersonScope;
+
+        std::vector<std::string> getIDList() const;
+        void subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const;
+        const libsumo::TraCIResults getSubscriptionResults(const std::string& id) const;
+
+        double getSpeed(const std::string& id) const;
+        libsumo::TraCIPosition getPosition(const std::string& id) const;
+        double getAngle(const std::string& id) const;
+        std::string getTypeID(const std::string& id) const;
+        void setSpeed(const std::string& id, double speed) const;
+
+    private:
+        bool embedded() const;
+    };
+
+    class PolygonScope : public TraCIAPI::PolygonScope
+    {
+    public:
+        using TraCIAPI::PolygonScope::PolygonScope;
+
+        std::vector<std::string> getIDList() const;
+        std::string getType(const std::string& id) const;
+        libsumo::TraCIPositionVector getShape(const std::string& id) const;
+        bool getFilled(const std::string& id) const;
+
+    private:
+        bool embedded() const;
+    };
+
+    class SimulationScope : public TraCIAPI::SimulationScope
+    {
+    public:
+        using TraCIAPI::SimulationScope::SimulationScope;
+
+        void subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const;
+        const libsumo::TraCIResults getSubscriptionResults(const std::string& id) const;
+
+        int getCurrentTime() const;
+        double getDeltaT() const;
+        libsumo::TraCIPositionVector getNetBoundary() const;
+        int getMinExpectedNumber() const;
+        libsumo::TraCIPosition convertGeo(double x, double y, bool fromGeo = false) const;
+
+    private:
+        bool embedded() const;
+    };
+
+    class VehicleScope : public TraCIAPI::VehicleScope
+    {
+    public:
+        using TraCIAPI::VehicleScope::VehicleScope;
+
+        std::vector<std::string> getIDList() const;
+        void subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const;
+        const libsumo::TraCIResults getSubscriptionResults(const std::string& id) const;
+
+        double getSpeed(const std::string& id) const;
+        libsumo::TraCIPosition getPosition(const std::string& id) const;
+        double getAngle(const std::string& id) const;
+        std::string getTypeID(const std::string& id) const;
+        void setSpeed(const std::string& id, double speed) const;
+        void setSpeedMode(const std::string& id, int mode) const;
+        void setSpeedFactor(const std::string& id, double factor) const;
+        void setMaxSpeed(const std::string& id, double speed) const;
+        void slowDown(const std::string& id, double speed, double duration) const;
+        void changeTarget(const std::string& id, const std::string& edge) const;
+
+    private:
+        bool embedded() const;
+    };
+
+    class VehicleTypeScope : public TraCIAPI::VehicleTypeScope
+    {
+    public:
+        using TraCIAPI::VehicleTypeScope::VehicleTypeScope;
+
+        std::string getVehicleClass(const std::string& id) const;
+        double getMaxSpeed(const std::string& id) const;
+        double getAccel(const std::string& id) const;
+        double getDecel(const std::string& id) const;
+        double getEmergencyDecel(const std::string& id) const;
+        double getLength(const std::string& id) const;
+        double getWidth(const std::string& id) const;
+        double getHeight(const std::string& id) const;
+
+    private:
+        bool embedded() const;
+    };
+
+    void close();
+    Version getVersion();
+
+    PersonScope person;
+    PolygonScope polygon;
+    SimulationScope simulation;
+    VehicleScope vehicle;
+    VehicleTypeScope vehicletype;
+#endif
+
+protected:
+    void check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0) const override;
+    bool processGet(int command, int expectedType, bool ignoreCommandId = false) override;
+    bool processSet(int command) override;
+
+private:
+#ifdef WITH_LIBSUMO
+    void stepEmbedded(double time);
+#endif
+    void decodeStep();
+    void receiveDeferredAcknowledgements();
+
+    bool m_embedded = false;
+    std::map<int, SubscriptionRecords*> m_records;
+    tcpip::Storage m_step_response;
+    mutable std::vector<int> m_deferred_acks;
+    bool m_step_requested = false;
+#ifdef WITH_LIBSUMO
+    double m_step_time = 0.0;
+#endif
 };
 
 } // namespace traci
 
 #endif /* API_H_HBQVASFR */
-
@@ -7,6 +7,7 @@
 #include "traci/VariableCache.h"
 #include "traci/VehicleSink.h"
 #include <inet/common/ModuleAccess.h>
+#include <cmath>
 
 using namespace omnetpp;
 
@@ -39,6 +40,17 @@ private:
     std::shared_ptr<VehicleCache> m_cache;
 };
 
+class UpdatedVehiclesImpl : public BasicNodeManager::UpdatedVehicles
+{
+public:
+    UpdatedVehiclesImpl(const std::vector<std::string>& ids) : m_ids(ids) {}
+
+    const std::vector<std::string>& getVehicleIds() const override { return m_ids; }
+
+private:
+    const std::vector<std::string>& m_ids;
+};
+
 class PersonObjectImpl : public BasicNodeManager::PersonObject
 {
 public:
@@ -68,6 +80,7 @@ const simsignal_t BasicNodeManager::removePersonSignal = cComponent::registerSig
 const simsignal_t BasicNodeManager::addVehicleSignal = cComponent::registerSignal("traci.vehicle.add");
 const simsignal_t BasicNodeManager::updateVehicleSignal = cComponent::registerSignal("traci.vehicle.update");
 const simsignal_t BasicNodeManager::removeVehicleSignal = cComponent::registerSignal("traci.vehicle.remove");
+const simsignal_t BasicNodeManager::stepVehiclesSignal = cComponent::registerSignal("traci.vehicle.step");
 
 void BasicNodeManager::initialize()
 {
@@ -81,6 +94,10 @@ void BasicNodeManager::initialize()
     m_subscriptions = inet::getModuleFromPar<SubscriptionManager>(par("subscriptionsModule"), this);
     m_destroy_vehicles_on_crash = par("destroyVehiclesOnCrash");
     m_ignore_persons = par("ignorePersons");
+    m_changed_vehicles_only = par("updateChangedVehiclesOnly");
+    m_position_threshold = par("positionThreshold");
+    m_angle_threshold = par("angleThreshold");
+    m_speed_threshold = par("speedThreshold");
 
 }
 
@@ -96,9 +113,12 @@ void BasicNodeManager::traciInit()
     m_subscriptions->subscribeSimulationVariables(sSimulationVariables);
     m_subscriptions->subscribeVehicleVariables(sVehicleVariables);
 
-    // insert already running vehicles
+    // insert already running vehicles (unless limited to subscription contexts)
+    const auto& subscribed = m_subscriptions->getSubscribedVehicles();
     for (const std::string& id : m_api->vehicle.getIDList()) {
-        addVehicle(id);
+        if (subscribed.find(id) != subscribed.end()) {
+            addVehicle(id);
+        }
     }
 
     // initialize persons if enabled
@@ -137,13 +157,14 @@ void BasicNodeManager::processVehicles()
     auto sim_cache = m_subscriptions->getSimulationCache();
     ASSERT(checkTimeSync(*sim_cache, omnetpp::simTime() + m_offset));
 
-    const auto& departed = sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>();
+    // departed or arrived vehicles, or those entering or leaving subscription contexts
+    const auto& departed = m_subscriptions->getAddedVehicles();
     EV_DETAIL << "TraCI: " << departed.size() << " vehicles departed" << endl;
     for (const auto& id : departed) {
         addVehicle(id);
     }
 
-    const auto& arrived = sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>();
+    const auto& arrived = m_subscriptions->getRemovedVehicles();
     EV_DETAIL << "TraCI: " << arrived.size() << " vehicles arrived" << endl;
     for (const auto& id : arrived) {
         removeVehicle(id);
@@ -157,21 +178,60 @@ void BasicNodeManager::processVehicles()
         }
     }
 
+    // listing updated vehicles is only worth the effort if somebody is interested
+    const bool list_updated = mayHaveListeners(stepVehiclesSignal);
+    m_updated_vehicles.clear();
     for (auto& vehicle : m_vehicles) {
         const std::string& id = vehicle.first;
-        VehicleSink* sink = vehicle.second;
-        updateVehicle(id, sink);
+        VehicleEntry& entry = vehicle.second;
+        if (m_changed_vehicles_only && !hasChanged(entry)) {
+            continue;
+        }
+
+        updateVehicle(id, entry.sink, entry.cache);
+        if (list_updated) {
+            m_updated_vehicles.push_back(id);
+        }
+    }
+
+    if (list_updated) {
+        UpdatedVehiclesImpl updated(m_updated_vehicles);
+        emit(stepVehiclesSignal, static_cast<unsigned long>(m_updated_vehicles.size()), &updated);
+    }
+}
+
+bool BasicNodeManager::hasChanged(VehicleEntry& entry) const
+{
+    const auto& position = entry.cache->get<libsumo::VAR_POSITION>();
+    const double angle = entry.cache->get<libsumo::VAR_ANGLE>();
+    const double speed = entry.cache->get<libsumo::VAR_SPEED>();
+
+    // compare with last update so slow movements are not lost by step-wise comparison
+    if (entry.updated &&
+            std::hypot(position.x - entry.position.x, position.y - entry.position.y) <= m_position_threshold &&
+            std::abs(std::remainder(angle - entry.angle, 360.0)) <= m_angle_threshold &&
+            std::abs(speed - entry.speed) <= m_speed_threshold) {
+        return false;
     }
+
+    entry.updated = true;
+    entry.position = position;
+    entry.angle = angle;
+    entry.speed = speed;
+    return true;
 }
 
 void BasicNodeManager::addVehicle(const std::string& id)
 {
-    NodeInitializer init = [this, &id](cModule* module) {
+    auto cache = m_subscriptions->getVehicleCache(id);
+    NodeInitializer init = [this, &id, &cache](cModule* module) {
         VehicleSink* vehicle = getVehicleSink(module);
-        auto& traci = m_api->vehicle;
-        vehicle->initializeSink(m_api, m_subscriptions->getVehicleCache(id), m_boundary);
-        vehicle->initializeVehicle(traci.getPosition(id), TraCIAngle { traci.getAngle(id) }, traci.getSpeed(id));
-        m_vehicles[id] = vehicle;
+        vehicle->initializeSink(m_api, cache, m_boundary);
+        // subscription response of a departed vehicle already provides its pose
+        vehicle->initializeVehicle(cache->get<libsumo::VAR_POSITION>(),
+                TraCIAngle { cache->get<libsumo::VAR_ANGLE>() },
+                cache->get<libsumo::VAR_SPEED>());
+        m_vehicles[id] = VehicleEntry { vehicle, cache };
     };
 
     emit(addVehicleSignal, id.c_str());
@@ -179,7 +239,7 @@ void BasicNodeManager::addVehicle(const std::string& id)
     if (type != nullptr) {
         addNodeModule(id, type, init);
     } else {
-        m_vehicles[id] = nullptr;
+        m_vehicles[id] = VehicleEntry { nullptr, cache };
     }
 }
 
@@ -190,9 +250,8 @@ void BasicNodeManager::removeVehicle(const std::string& id)
     m_vehicles.erase(id);
 }
 
-void BasicNodeManager::updateVehicle(const std::string& id, VehicleSink* sink)
+void BasicNodeManager::updateVehicle(const std::string& id, VehicleSink* sink, const std::shared_ptr<VehicleCache>& vehicle)
 {
-    auto vehicle = m_subscriptions->getVehicleCache(id);
     VehicleObjectImpl update(vehicle);
     emit(updateVehicleSignal, id.c_str(), &update);
     if (sink) {
@@ -229,9 +288,11 @@ void BasicNodeManager::addPerson(const std::string& id)
 {
     NodeInitializer init = [this, &id](cModule* module) {
         PersonSink* person = getPersonSink(module);
-        auto& traci = m_api->person;
-        person->initializeSink(m_api, m_subscriptions->getPersonCache(id), m_boundary);
-        person->initializePerson(traci.getPosition(id), TraCIAngle { traci.getAngle(id) }, traci.getSpeed(id));
+        auto cache = m_subscriptions->getPersonCache(id);
+        person->initializeSink(m_api, cache, m_boundary);
+        person->initializePerson(cache->get<libsumo::VAR_POSITION>(),
+                TraCIAngle { cache->get<libsumo::VAR_ANGLE>() },
+                cache->get<libsumo::VAR_SPEED>());
         m_persons[id] = person;
     };
 
@@ -327,7 +388,7 @@ VehicleSink* BasicNodeManager::getVehicleSink(cModule* node)
 VehicleSink* BasicNodeManager::getVehicleSink(const std::string& id)
 {
     auto found = m_vehicles.find(id);
-    return found != m_vehicles.end() ? found->second : nullptr;
+    return found != m_vehicles.end() ? found->second.sink : nullptr;
 }
 
 PersonSink* BasicNodeManager::getPersonSink(cModule* node)
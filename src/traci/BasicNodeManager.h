@@ -13,6 +13,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace traci
 {
@@ -35,6 +36,7 @@ public:
     static const omnetpp::simsignal_t addVehicleSignal;
     static const omnetpp::simsignal_t updateVehicleSignal;
     static const omnetpp::simsignal_t removeVehicleSignal;
+    static const omnetpp::simsignal_t stepVehiclesSignal;
 
     std::shared_ptr<API> getAPI() override { return m_api; }
     SubscriptionManager* getSubscriptions() { return m_subscriptions; }
@@ -54,6 +56,18 @@ public:
         virtual double getSpeed() const = 0;
     };
 
+    /**
+     * UpdatedVehicles lists vehicles updated in a step
+     *
+     * Emitted as cObject details of the vehicle step signal once all vehicles have been processed.
+     * Only vehicles whose state changed beyond configured thresholds are listed if change detection is enabled.
+     */
+    class UpdatedVehicles : public omnetpp::cObject
+    {
+    public:
+        virtual const std::vector<std::string>& getVehicleIds() const = 0;
+    };
+
     class PersonObject : public omnetpp::cObject
     {
     public:
@@ -75,7 +89,7 @@ protected:
     virtual void updatePerson(const std::string&, PersonSink*);
     virtual void addVehicle(const std::string&);
     virtual void removeVehicle(const std::string&);
-    virtual void updateVehicle(const std::string&, VehicleSink*);
+    virtual void updateVehicle(const std::string&, VehicleSink*, const std::shared_ptr<VehicleCache>&);
     virtual omnetpp::cModule* createModule(const std::string&, omnetpp::cModuleType*);
     virtual omnetpp::cModule* addNodeModule(const std::string&, omnetpp::cModuleType*, NodeInitializer&);
     virtual void removeNodeModule(const std::string&);
@@ -92,6 +106,20 @@ protected:
     void traciClose() override;
 
 private:
+    struct VehicleEntry
+    {
+        VehicleSink* sink;
+        std::shared_ptr<VehicleCache> cache;
+
+        // state of last update
+        bool updated = false;
+        TraCIPosition position;
+        double angle = 0.0;
+        double speed = 0.0;
+    };
+
+    bool hasChanged(VehicleEntry&) const;
+
     std::shared_ptr<API> m_api;
     ModuleMapper* m_mapper;
     Boundary m_boundary;
@@ -99,11 +127,16 @@ private:
     unsigned m_nodeIndex;
     std::map<std::string, omnetpp::cModule*> m_nodes;
     std::map<std::string, PersonSink*> m_persons;
-    std::map<std::string, VehicleSink*> m_vehicles;
+    std::map<std::string, VehicleEntry> m_vehicles;
     std::string m_vehicle_sink_module;
     std::string m_person_sink_module;
     bool m_destroy_vehicles_on_crash;
     bool m_ignore_persons;
+    bool m_changed_vehicles_only;
+    double m_position_threshold;
+    double m_angle_threshold;
+    double m_speed_threshold;
+    std::vector<std::string> m_updated_vehicles;
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
 };
 
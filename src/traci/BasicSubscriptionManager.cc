@@ -9,14 +9,30 @@
 #include "traci/CheckTimeSync.h"
 #include "traci/Core.h"
 #include "traci/VariableCache.h"
+#include <boost/lexical_cast.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <algorithm>
+#include <cmath>
 
 using namespace omnetpp;
 
 namespace traci
 {
 
+namespace
+{
+
+double getAttribute(const cXMLElement& element, const char* name)
+{
+    const char* value = element.getAttribute(name);
+    if (!value) {
+        throw cRuntimeError("Missing attribute \"%s\" at %s", name, element.getSourceLocation());
+    }
+    return boost::lexical_cast<double>(value);
+}
+
+} // namespace
+
 Define_Module(BasicSubscriptionManager)
 
 BasicSubscriptionManager::BasicSubscriptionManager() : m_api(nullptr)
@@ -30,10 +46,71 @@ void BasicSubscriptionManager::initialize()
     m_api = core->getAPI();
     m_sim_cache = std::make_shared<SimulationCache>(m_api);
     m_ignore_persons = par("ignorePersons");
+
+    cXMLElement* contexts = par("vehicleContexts").xmlValue();
+    if (contexts) {
+        initializeContexts(*contexts);
+    }
+}
+
+void BasicSubscriptionManager::initializeContexts(const cXMLElement& contexts)
+{
+    const double margin = par("contextMargin");
+    for (cXMLElement* element : contexts.getChildren()) {
+        const std::string tag = element->getTagName();
+        if (tag == "polygon") {
+            // same schema as RegionsOfInterest, context covers polygon by a circle around its centre
+            std::vector<std::pair<double, double>> points;
+            for (cXMLElement* point : element->getChildrenByTagName("point")) {
+                points.emplace_back(getAttribute(*point, "x"), getAttribute(*point, "y"));
+            }
+            if (points.empty()) {
+                throw cRuntimeError("Vehicle context polygon without points at %s", element->getSourceLocation());
+            }
+
+            auto x = std::minmax_element(points.begin(), points.end(),
+                    [](const std::pair<double, double>& a, const std::pair<double, double>& b) { return a.first < b.first; });
+            auto y = std::minmax_element(points.begin(), points.end(),
+                    [](const std::pair<double, double>& a, const std::pair<double, double>& b) { return a.second < b.second; });
+            RegionContext region;
+            region.x = 0.5 * (x.first->first + x.second->first);
+            region.y = 0.5 * (y.first->second + y.second->second);
+            region.range = 0.0;
+            for (const auto& point : points) {
+                region.range = std::max(region.range, std::hypot(point.first - region.x, point.second - region.y));
+            }
+            region.range += margin;
+            m_region_contexts.push_back(region);
+        } else if (tag == "circle") {
+            RegionContext region;
+            region.x = getAttribute(*element, "x");
+            region.y = getAttribute(*element, "y");
+            region.range = getAttribute(*element, "radius") + margin;
+            m_region_contexts.push_back(region);
+        } else if (tag == "vehicle") {
+            const char* id = element->getAttribute("id");
+            if (!id) {
+                throw cRuntimeError("Missing attribute \"id\" at %s", element->getSourceLocation());
+            }
+            m_window_contexts[id] = getAttribute(*element, "radius") + margin;
+        } else {
+            throw cRuntimeError("Unknown vehicle context <%s> at %s", tag.c_str(), element->getSourceLocation());
+        }
+    }
+
+    for (std::size_t i = 0; i < m_region_contexts.size(); ++i) {
+        m_region_contexts[i].poi = std::string(getFullPath()) + ".context" + std::to_string(i);
+    }
+    EV_INFO << "Vehicles subscribed within " << m_region_contexts.size() << " regions and "
+        << m_window_contexts.size() << " vehicle windows" << endl;
 }
 
 void BasicSubscriptionManager::finish()
 {
+    for (int response : { libsumo::RESPONSE_SUBSCRIBE_PERSON_VARIABLE, libsumo::RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE, libsumo::RESPONSE_SUBSCRIBE_SIM_VARIABLE,
+            libsumo::RESPONSE_SUBSCRIBE_POI_CONTEXT, libsumo::RESPONSE_SUBSCRIBE_VEHICLE_CONTEXT }) {
+        m_api->setSubscriptionRecords(response, nullptr);
+    }
     m_api = nullptr;
     unsubscribeTraCI();
     cSimpleModule::finish();
@@ -49,11 +126,39 @@ void BasicSubscriptionManager::traciInit()
         VAR_TELEPORT_STARTING_VEHICLES_IDS,
         VAR_TIME
     };
+
+    // decode subscription responses into reusable records unless SUMO is embedded
+    if (!m_api->isEmbedded()) {
+        m_api->setSubscriptionRecords(RESPONSE_SUBSCRIBE_PERSON_VARIABLE, &m_person_records);
+        m_api->setSubscriptionRecords(RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE, &m_vehicle_records);
+        m_api->setSubscriptionRecords(RESPONSE_SUBSCRIBE_SIM_VARIABLE, &m_sim_records);
+    }
+
     subscribeSimulationVariables(vars);
 
-    // subscribe already running vehicles
-    for (const std::string& id : m_api->vehicle.getIDList()) {
-        subscribeVehicle(id);
+    if (hasContexts()) {
+        if (m_api->isEmbedded()) {
+            throw cRuntimeError("Vehicle contexts are not supported with embedded SUMO");
+        }
+        m_api->setSubscriptionRecords(RESPONSE_SUBSCRIBE_POI_CONTEXT, &m_vehicle_records);
+        m_api->setSubscriptionRecords(RESPONSE_SUBSCRIBE_VEHICLE_CONTEXT, &m_vehicle_records);
+
+        // an invisible point of interest serves as ego object of each region
+        for (const RegionContext& region : m_region_contexts) {
+            m_api->poi.add(region.poi, region.x, region.y, libsumo::TraCIColor(0, 0, 0, 0), "artery.context", 0, "", 0.0, 0.0, 0.0);
+        }
+
+        // running vehicles get subscribed when reported by a context
+        for (const std::string& id : m_api->vehicle.getIDList()) {
+            if (m_window_contexts.find(id) != m_window_contexts.end()) {
+                m_active_windows.insert(id);
+            }
+        }
+    } else {
+        // subscribe already running vehicles
+        for (const std::string& id : m_api->vehicle.getIDList()) {
+            subscribeVehicle(id);
+        }
     }
 
     // subscribe already running persons
@@ -89,6 +194,7 @@ void BasicSubscriptionManager::unsubscribePerson(const std::string& id, bool per
         updatePersonSubscription(id, empty);
     }
     m_subscribed_persons.insert(id);
+    releaseRecord(m_person_records, id, m_person_caches);
 }
 
 void BasicSubscriptionManager::updatePersonSubscription(const std::string& id, const std::vector<int>& vars)
@@ -112,19 +218,34 @@ void BasicSubscriptionManager::subscribePersonVariables(const std::set<int>& add
 
 void BasicSubscriptionManager::subscribeVehicle(const std::string& id)
 {
-    if (!m_vehicle_vars.empty()) {
+    // vehicles reported by contexts are not subscribed individually
+    if (!m_vehicle_vars.empty() && !hasContexts()) {
         updateVehicleSubscription(id, m_vehicle_vars);
     }
     m_subscribed_vehicles.insert(id);
+
+    if (m_vehicle_slots.find(id) == m_vehicle_slots.end()) {
+        VehicleSlot vehicle { getVehicleCache(id), m_vehicle_states.allocate() };
+        vehicle.cache->attach(m_vehicle_states, vehicle.slot);
+        m_vehicle_slots.emplace(id, std::move(vehicle));
+    }
 }
 
 void BasicSubscriptionManager::unsubscribeVehicle(const std::string& id, bool vehicle_exists)
 {
-    if (vehicle_exists && !m_vehicle_vars.empty()) {
+    if (vehicle_exists && !m_vehicle_vars.empty() && !hasContexts()) {
         static const std::vector<int> empty;
         updateVehicleSubscription(id, empty);
     }
     m_subscribed_vehicles.erase(id);
+    releaseRecord(m_vehicle_records, id, m_vehicle_caches);
+
+    auto found = m_vehicle_slots.find(id);
+    if (found != m_vehicle_slots.end()) {
+        found->second.cache->detach();
+        m_vehicle_states.release(found->second.slot);
+        m_vehicle_slots.erase(found);
+    }
 }
 
 void BasicSubscriptionManager::updateVehicleSubscription(const std::string& id, const std::vector<int>& vars)
@@ -140,12 +261,69 @@ void BasicSubscriptionManager::subscribeVehicleVariables(const std::set<int>& ad
     ASSERT(m_vehicle_vars.size() >= tmp_vars.size());
 
     if (m_vehicle_vars.size() != tmp_vars.size()) {
-        for (const std::string& vehicle : m_subscribed_vehicles) {
-            updateVehicleSubscription(vehicle, m_vehicle_vars);
+        if (hasContexts()) {
+            updateContextSubscriptions();
+        } else {
+            for (const std::string& vehicle : m_subscribed_vehicles) {
+                updateVehicleSubscription(vehicle, m_vehicle_vars);
+            }
         }
     }
 }
 
+void BasicSubscriptionManager::updateContextSubscriptions()
+{
+    for (const RegionContext& region : m_region_contexts) {
+        m_api->poi.subscribeContext(region.poi, libsumo::CMD_GET_VEHICLE_VARIABLE, region.range, m_vehicle_vars,
+                libsumo::INVALID_DOUBLE_VALUE, libsumo::INVALID_DOUBLE_VALUE);
+    }
+    for (const std::string& ego : m_active_windows) {
+        updateWindowSubscription(ego);
+    }
+}
+
+void BasicSubscriptionManager::updateWindowSubscription(const std::string& ego)
+{
+    if (!m_vehicle_vars.empty()) {
+        m_api->vehicle.subscribeContext(ego, libsumo::CMD_GET_VEHICLE_VARIABLE, m_window_contexts.at(ego), m_vehicle_vars,
+                libsumo::INVALID_DOUBLE_VALUE, libsumo::INVALID_DOUBLE_VALUE);
+    }
+}
+
+void BasicSubscriptionManager::stepContexts()
+{
+    // moving windows follow their ego vehicle while it is running
+    for (const auto& id : m_sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>()) {
+        m_active_windows.erase(id);
+    }
+    for (const auto& id : m_sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>()) {
+        if (m_window_contexts.find(id) != m_window_contexts.end()) {
+            m_active_windows.insert(id);
+            updateWindowSubscription(id);
+        }
+    }
+
+    // vehicles missing in all context responses have left the regions (or arrived)
+    for (const std::string& id : m_subscribed_vehicles) {
+        if (!m_vehicle_records.find(id)) {
+            m_removed_vehicles.push_back(id);
+        }
+    }
+    std::sort(m_removed_vehicles.begin(), m_removed_vehicles.end());
+    for (const auto& id : m_removed_vehicles) {
+        unsubscribeVehicle(id, false);
+    }
+
+    for (const std::string& id : m_vehicle_records.updated()) {
+        if (m_subscribed_vehicles.find(id) == m_subscribed_vehicles.end()) {
+            m_added_vehicles.push_back(id);
+        }
+    }
+    for (const auto& id : m_added_vehicles) {
+        subscribeVehicle(id);
+    }
+}
+
 void BasicSubscriptionManager::subscribeSimulationVariables(const std::set<int>& add_vars)
 {
     std::vector<int> tmp_vars;
@@ -160,24 +338,42 @@ void BasicSubscriptionManager::subscribeSimulationVariables(const std::set<int>&
 
 void BasicSubscriptionManager::step()
 {
-    const auto& simvars = m_api->simulation.getSubscriptionResults("");
-    m_sim_cache->reset(simvars);
+    if (const SubscriptionRecord* record = m_sim_records.find("")) {
+        m_sim_cache->reset(*record);
+    } else {
+        m_sim_cache->reset(m_api->simulation.getSubscriptionResults(""));
+    }
     ASSERT(checkTimeSync(*m_sim_cache, omnetpp::simTime() + m_offset));
 
-    const auto& arrivedVehicles = m_sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>();
-    for (const auto& id : arrivedVehicles) {
-        unsubscribeVehicle(id, false);
-    }
+    m_added_vehicles.clear();
+    m_removed_vehicles.clear();
+    if (hasContexts()) {
+        stepContexts();
+    } else {
+        const auto& arrivedVehicles = m_sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>();
+        for (const auto& id : arrivedVehicles) {
+            unsubscribeVehicle(id, false);
+        }
+        m_removed_vehicles.assign(arrivedVehicles.begin(), arrivedVehicles.end());
 
-    const auto& departedVehicles = m_sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>();
-    for (const auto& id : departedVehicles) {
-        subscribeVehicle(id);
+        const auto& departedVehicles = m_sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>();
+        for (const auto& id : departedVehicles) {
+            subscribeVehicle(id);
+        }
+        m_added_vehicles.assign(departedVehicles.begin(), departedVehicles.end());
     }
 
     const auto& vehicles = m_api->vehicle;
-    for (const std::string& vehicle : m_subscribed_vehicles) {
-        const auto& vars = vehicles.getSubscriptionResults(vehicle);
-        getVehicleCache(vehicle)->reset(vars);
+    for (auto& vehicle : m_vehicle_slots) {
+        VehicleCache& cache = *vehicle.second.cache;
+        if (const SubscriptionRecord* record = m_vehicle_records.find(vehicle.first)) {
+            m_vehicle_states.update(vehicle.second.slot, *record);
+            cache.reset(*record);
+        } else {
+            const libsumo::TraCIResults results = vehicles.getSubscriptionResults(vehicle.first);
+            m_vehicle_states.update(vehicle.second.slot, results);
+            cache.reset(results);
+        }
     }
 
     if (!m_ignore_persons) {
@@ -193,12 +389,27 @@ void BasicSubscriptionManager::step()
 
         const auto& persons = m_api->person;
         for (const std::string& person : m_subscribed_persons) {
-            const auto& vars = persons.getSubscriptionResults(person);
-            getPersonCache(person)->reset(vars);
+            if (const SubscriptionRecord* record = m_person_records.find(person)) {
+                getPersonCache(person)->reset(*record);
+            } else {
+                getPersonCache(person)->reset(persons.getSubscriptionResults(person));
+            }
         }
     }
 }
 
+template<typename Cache>
+void BasicSubscriptionManager::releaseRecord(SubscriptionRecords& records, const std::string& id,
+        std::unordered_map<std::string, std::shared_ptr<Cache>>& caches)
+{
+    // cache must not reference a dropped record
+    auto cache = caches.find(id);
+    if (cache != caches.end()) {
+        cache->second->reset(libsumo::TraCIResults {});
+    }
+    records.erase(id);
+}
+
 std::shared_ptr<PersonCache> BasicSubscriptionManager::getPersonCache(const std::string& id)
 {
     auto found = m_person_caches.find(id);
@@ -233,6 +444,16 @@ const std::unordered_set<std::string>& BasicSubscriptionManager::getSubscribedVe
     return m_subscribed_vehicles;
 }
 
+const std::vector<std::string>& BasicSubscriptionManager::getAddedVehicles() const
+{
+    return m_added_vehicles;
+}
+
+const std::vector<std::string>& BasicSubscriptionManager::getRemovedVehicles() const
+{
+    return m_removed_vehicles;
+}
+
 const std::unordered_map<std::string, std::shared_ptr<VehicleCache>>& BasicSubscriptionManager::getAllVehicleCaches() const
 {
     return m_vehicle_caches;
@@ -9,7 +9,10 @@
 
 #include "traci/Listener.h"
 #include "traci/SubscriptionManager.h"
+#include "traci/SubscriptionRecords.h"
+#include "traci/VehicleStateTable.h"
 #include <omnetpp/csimplemodule.h>
+#include <omnetpp/cxmlelement.h>
 #include <omnetpp/simtime.h>
 #include <unordered_map>
 #include <unordered_set>
@@ -31,6 +34,8 @@ public:
     void subscribeSimulationVariables(const std::set<int>& simulationVariables) override;
     const std::unordered_set<std::string>& getSubscribedPersons() const override;
     const std::unordered_set<std::string>& getSubscribedVehicles() const override;
+    const std::vector<std::string>& getAddedVehicles() const override;
+    const std::vector<std::string>& getRemovedVehicles() const override;
     const std::unordered_map<std::string, std::shared_ptr<VehicleCache>>& getAllVehicleCaches() const override;
     std::shared_ptr<PersonCache> getPersonCache(const std::string& id) override;
     std::shared_ptr<VehicleCache> getVehicleCache(const std::string& id) override;
@@ -56,6 +61,15 @@ private:
     void unsubscribeVehicle(const std::string& id, bool vehicle_exists);
     void updateVehicleSubscription(const std::string& id, const std::vector<int>& vars);
 
+    void initializeContexts(const omnetpp::cXMLElement&);
+    bool hasContexts() const { return !m_region_contexts.empty() || !m_window_contexts.empty(); }
+    void stepContexts();
+    void updateContextSubscriptions();
+    void updateWindowSubscription(const std::string& ego);
+
+    template<typename Cache>
+    void releaseRecord(SubscriptionRecords&, const std::string& id, std::unordered_map<std::string, std::shared_ptr<Cache>>&);
+
     std::shared_ptr<API> m_api;
     std::unordered_set<std::string> m_subscribed_persons;
     std::unordered_set<std::string> m_subscribed_vehicles;
@@ -65,6 +79,32 @@ private:
     std::unordered_map<std::string, std::shared_ptr<PersonCache>> m_person_caches;
     std::unordered_map<std::string, std::shared_ptr<VehicleCache>> m_vehicle_caches;
     std::shared_ptr<SimulationCache> m_sim_cache;
+    SubscriptionRecords m_person_records;
+    SubscriptionRecords m_vehicle_records;
+    SubscriptionRecords m_sim_records;
+
+    struct VehicleSlot
+    {
+        std::shared_ptr<VehicleCache> cache;
+        VehicleStateTable::Slot slot;
+    };
+    VehicleStateTable m_vehicle_states;
+    std::unordered_map<std::string, VehicleSlot> m_vehicle_slots;
+    std::vector<std::string> m_added_vehicles;
+    std::vector<std::string> m_removed_vehicles;
+
+    // vehicles are only subscribed within range of these egos if any context is configured
+    struct RegionContext
+    {
+        std::string poi;
+        double x;
+        double y;
+        double range;
+    };
+    std::vector<RegionContext> m_region_contexts;
+    std::unordered_map<std::string, double> m_window_contexts;
+    std::unordered_set<std::string> m_active_windows;
+
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
     bool m_ignore_persons;
 };
@@ -38,6 +38,7 @@ void Core::initialize()
     cModule* manager = getParentModule();
     m_launcher = inet::getModuleFromPar<Launcher>(par("launcherModule"), manager);
     m_stopping = par("selfStopping");
+    m_pipelined = par("pipelined");
     scheduleAt(par("startTime"), m_connectEvent);
     m_subscriptions = inet::getModuleFromPar<SubscriptionManager>(par("subscriptionsModule"), manager, false);
 }
@@ -46,6 +47,10 @@ void Core::finish()
 {
     emit(closeSignal, simTime());
     if (!m_connectEvent->isScheduled()) {
+        if (m_traci->isStepPending()) {
+            // SUMO does not accept close command before pending step response has been read
+            m_traci->completeSimulationStep();
+        }
         m_traci->close();
     }
 }
@@ -53,7 +58,11 @@ void Core::finish()
 void Core::handleMessage(cMessage* msg)
 {
     if (msg == m_updateEvent) {
-        m_traci->simulationStep();
+        if (m_traci->isStepPending()) {
+            m_traci->completeSimulationStep();
+        } else {
+            m_traci->simulationStep();
+        }
         if (m_subscriptions) {
             m_subscriptions->step();
         }
@@ -61,6 +70,10 @@ void Core::handleMessage(cMessage* msg)
 
         if (!m_stopping || m_traci->simulation.getMinExpectedNumber() > 0) {
             scheduleAt(simTime() + m_updateInterval, m_updateEvent);
+            if (m_pipelined) {
+                // SUMO computes next step while OMNeT++ processes events until next update
+                m_traci->requestSimulationStep();
+            }
         }
     } else if (msg == m_connectEvent) {
         m_traci->connect(m_launcher->launch());
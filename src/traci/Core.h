@@ -37,6 +37,7 @@ private:
     Launcher* m_launcher;
     std::shared_ptr<API> m_traci;
     bool m_stopping;
+    bool m_pipelined;
     SubscriptionManager* m_subscriptions;
 };
 
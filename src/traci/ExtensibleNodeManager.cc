@@ -29,7 +29,8 @@ void ExtensibleNodeManager::VehicleLifecycle::removeVehicle(const std::string& i
 
 void ExtensibleNodeManager::VehicleLifecycle::updateVehicle(const std::string& id)
 {
-    m_manager->updateVehicle(m_policy, id, m_manager->getVehicleSink(id));
+    m_manager->updateVehicle(m_policy, id, m_manager->getVehicleSink(id),
+            m_manager->getSubscriptions()->getVehicleCache(id));
 }
 
 
@@ -108,12 +109,13 @@ void ExtensibleNodeManager::removeVehicle(const VehiclePolicy* omit, const std::
     }
 }
 
-void ExtensibleNodeManager::updateVehicle(const std::string& id, VehicleSink* sink)
+void ExtensibleNodeManager::updateVehicle(const std::string& id, VehicleSink* sink, const std::shared_ptr<VehicleCache>& cache)
 {
-    updateVehicle(nullptr, id, sink);
+    updateVehicle(nullptr, id, sink, cache);
 }
 
-void ExtensibleNodeManager::updateVehicle(const VehiclePolicy* omit, const std::string& id, VehicleSink* sink)
+void ExtensibleNodeManager::updateVehicle(const VehiclePolicy* omit, const std::string& id, VehicleSink* sink,
+        const std::shared_ptr<VehicleCache>& cache)
 {
     for (VehiclePolicy* policy : m_policies) {
         if (policy != omit && policy->updateVehicle(id) == VehiclePolicy::Decision::Discard) {
@@ -121,7 +123,7 @@ void ExtensibleNodeManager::updateVehicle(const VehiclePolicy* omit, const std::
         }
     }
 
-    BasicNodeManager::updateVehicle(id, sink);
+    BasicNodeManager::updateVehicle(id, sink, cache);
 }
 
 } // namespace traci
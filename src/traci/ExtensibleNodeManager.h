@@ -34,13 +34,13 @@ protected:
 
     void processVehicles() override;
     void addVehicle(const std::string&) override;
-    void updateVehicle(const std::string&, VehicleSink*) override;
+    void updateVehicle(const std::string&, VehicleSink*, const std::shared_ptr<VehicleCache>&) override;
     void removeVehicle(const std::string&) override;
 
     friend class VehicleLifecycle;
     void addVehicle(const VehiclePolicy* omit, const std::string&);
     void removeVehicle(const VehiclePolicy* omit, const std::string&);
-    void updateVehicle(const VehiclePolicy* omit, const std::string&, VehicleSink*);
+    void updateVehicle(const VehiclePolicy* omit, const std::string&, VehicleSink*, const std::shared_ptr<VehicleCache>&);
 
 private:
     class VehicleLifecycle : public traci::VehicleLifecycle
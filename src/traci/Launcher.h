@@ -12,6 +12,8 @@ struct ServerEndpoint
     int port;
     int clientId = 1;
     bool retry = false;
+    // SUMO runs in-process via libsumo, i.e. hostname and port are unused
+    bool embedded = false;
 };
 
 class Launcher
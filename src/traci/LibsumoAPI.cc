@@ -0,0 +1,425 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/API.h"
+#include "traci/LibsumoVariables.h"
+#include <libsumo/Person.h>
+#include <libsumo/Polygon.h>
+#include <libsumo/Simulation.h>
+#include <libsumo/Vehicle.h>
+#include <libsumo/VehicleType.h>
+
+namespace traci
+{
+
+void API::stepEmbedded(double time)
+{
+    libsumo::Simulation::step(time);
+}
+
+void API::close()
+{
+    if (m_embedded) {
+        libsumo::Simulation::close();
+        m_embedded = false;
+    } else {
+        TraCIAPI::close();
+    }
+}
+
+API::Version API::getVersion()
+{
+    return m_embedded ? libsumo::Simulation::getVersion() : TraCIAPI::getVersion();
+}
+
+bool API::PersonScope::embedded() const
+{
+    return static_cast<const API&>(myParent).isEmbedded();
+}
+
+std::vector<std::string> API::PersonScope::getIDList() const
+{
+    return embedded() ? libsumo::Person::getIDList() : TraCIAPI::PersonScope::getIDList();
+}
+
+void API::PersonScope::subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const
+{
+    if (embedded()) {
+        libsumo::Person::subscribe(id, vars, begin, end);
+    } else {
+        TraCIAPI::PersonScope::subscribe(id, vars, begin, end);
+    }
+}
+
+const libsumo::TraCIResults API::PersonScope::getSubscriptionResults(const std::string& id) const
+{
+    return embedded() ? libsumo::Person::getSubscriptionResults(id) : TraCIAPI::PersonScope::getSubscriptionResults(id);
+}
+
+double API::PersonScope::getSpeed(const std::string& id) const
+{
+    return embedded() ? libsumo::Person::getSpeed(id) : TraCIAPI::PersonScope::getSpeed(id);
+}
+
+libsumo::TraCIPosition API::PersonScope::getPosition(const std::string& id) const
+{
+    return embedded() ? libsumo::Person::getPosition(id) : TraCIAPI::PersonScope::getPosition(id);
+}
+
+double API::PersonScope::getAngle(const std::string& id) const
+{
+    return embedded() ? libsumo::Person::getAngle(id) : TraCIAPI::PersonScope::getAngle(id);
+}
+
+std::string API::PersonScope::getTypeID(const std::string& id) const
+{
+    return embedded() ? libsumo::Person::getTypeID(id) : TraCIAPI::PersonScope::getTypeID(id);
+}
+
+void API::PersonScope::setSpeed(const std::string& id, double speed) const
+{
+    if (embedded()) {
+        libsumo::Person::setSpeed(id, speed);
+    } else {
+        TraCIAPI::PersonScope::setSpeed(id, speed);
+    }
+}
+
+bool API::PolygonScope::embedded() const
+{
+    return static_cast<const API&>(myParent).isEmbedded();
+}
+
+std::vector<std::string> API::PolygonScope::getIDList() const
+{
+    return embedded() ? libsumo::Polygon::getIDList() : TraCIAPI::PolygonScope::getIDList();
+}
+
+std::string API::PolygonScope::getType(const std::string& id) const
+{
+    return embedded() ? libsumo::Polygon::getType(id) : TraCIAPI::PolygonScope::getType(id);
+}
+
+libsumo::TraCIPositionVector API::PolygonScope::getShape(const std::string& id) const
+{
+    return embedded() ? libsumo::Polygon::getShape(id) : TraCIAPI::PolygonScope::getShape(id);
+}
+
+bool API::PolygonScope::getFilled(const std::string& id) const
+{
+    return embedded() ? libsumo::Polygon::getFilled(id) : TraCIAPI::PolygonScope::getFilled(id);
+}
+
+bool API::SimulationScope::embedded() const
+{
+    return static_cast<const API&>(myParent).isEmbedded();
+}
+
+void API::SimulationScope::subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const
+{
+    if (embedded()) {
+        libsumo::Simulation::subscribe(vars, begin, end);
+    } else {
+        TraCIAPI::SimulationScope::subscribe(id, vars, begin, end);
+    }
+}
+
+const libsumo::TraCIResults API::SimulationScope::getSubscriptionResults(const std::string& id) const
+{
+    return embedded() ? libsumo::Simulation::getSubscriptionResults() : TraCIAPI::SimulationScope::getSubscriptionResults(id);
+}
+
+int API::SimulationScope::getCurrentTime() const
+{
+    return embedded() ? libsumo::Simulation::getCurrentTime() : TraCIAPI::SimulationScope::getCurrentTime();
+}
+
+double API::SimulationScope::getDeltaT() const
+{
+    return embedded() ? libsumo::Simulation::getDeltaT() : TraCIAPI::SimulationScope::getDeltaT();
+}
+
+libsumo::TraCIPositionVector API::SimulationScope::getNetBoundary() const
+{
+    return embedded() ? libsumo::Simulation::getNetBoundary() : TraCIAPI::SimulationScope::getNetBoundary();
+}
+
+int API::SimulationScope::getMinExpectedNumber() const
+{
+    return embedded() ? libsumo::Simulation::getMinExpectedNumber() : TraCIAPI::SimulationScope::getMinExpectedNumber();
+}
+
+libsumo::TraCIPosition API::SimulationScope::convertGeo(double x, double y, bool fromGeo) const
+{
+    return embedded() ? libsumo::Simulation::convertGeo(x, y, fromGeo) : TraCIAPI::SimulationScope::convertGeo(x, y, fromGeo);
+}
+
+bool API::VehicleScope::embedded() const
+{
+    return static_cast<const API&>(myParent).isEmbedded();
+}
+
+std::vector<std::string> API::VehicleScope::getIDList() const
+{
+    return embedded() ? libsumo::Vehicle::getIDList() : TraCIAPI::VehicleScope::getIDList();
+}
+
+void API::VehicleScope::subscribe(const std::string& id, const std::vector<int>& vars, double begin, double end) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::subscribe(id, vars, begin, end);
+    } else {
+        TraCIAPI::VehicleScope::subscribe(id, vars, begin, end);
+    }
+}
+
+const libsumo::TraCIResults API::VehicleScope::getSubscriptionResults(const std::string& id) const
+{
+    return embedded() ? libsumo::Vehicle::getSubscriptionResults(id) : TraCIAPI::VehicleScope::getSubscriptionResults(id);
+}
+
+double API::VehicleScope::getSpeed(const std::string& id) const
+{
+    return embedded() ? libsumo::Vehicle::getSpeed(id) : TraCIAPI::VehicleScope::getSpeed(id);
+}
+
+libsumo::TraCIPosition API::VehicleScope::getPosition(const std::string& id) const
+{
+    return embedded() ? libsumo::Vehicle::getPosition(id) : TraCIAPI::VehicleScope::getPosition(id);
+}
+
+double API::VehicleScope::getAngle(const std::string& id) const
+{
+    return embedded() ? libsumo::Vehicle::getAngle(id) : TraCIAPI::VehicleScope::getAngle(id);
+}
+
+std::string API::VehicleScope::getTypeID(const std::string& id) const
+{
+    return embedded() ? libsumo::Vehicle::getTypeID(id) : TraCIAPI::VehicleScope::getTypeID(id);
+}
+
+void API::VehicleScope::setSpeed(const std::string& id, double speed) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::setSpeed(id, speed);
+    } else {
+        TraCIAPI::VehicleScope::setSpeed(id, speed);
+    }
+}
+
+void API::VehicleScope::setSpeedMode(const std::string& id, int mode) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::setSpeedMode(id, mode);
+    } else {
+        TraCIAPI::VehicleScope::setSpeedMode(id, mode);
+    }
+}
+
+void API::VehicleScope::setSpeedFactor(const std::string& id, double factor) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::setSpeedFactor(id, factor);
+    } else {
+        TraCIAPI::VehicleScope::setSpeedFactor(id, factor);
+    }
+}
+
+void API::VehicleScope::setMaxSpeed(const std::string& id, double speed) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::setMaxSpeed(id, speed);
+    } else {
+        TraCIAPI::VehicleScope::setMaxSpeed(id, speed);
+    }
+}
+
+void API::VehicleScope::slowDown(const std::string& id, double speed, double duration) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::slowDown(id, speed, duration);
+    } else {
+        TraCIAPI::VehicleScope::slowDown(id, speed, duration);
+    }
+}
+
+void API::VehicleScope::changeTarget(const std::string& id, const std::string& edge) const
+{
+    if (embedded()) {
+        libsumo::Vehicle::changeTarget(id, edge);
+    } else {
+        TraCIAPI::VehicleScope::changeTarget(id, edge);
+    }
+}
+
+bool API::VehicleTypeScope::embedded() const
+{
+    return static_cast<const API&>(myParent).isEmbedded();
+}
+
+std::string API::VehicleTypeScope::getVehicleClass(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getVehicleClass(id) : TraCIAPI::VehicleTypeScope::getVehicleClass(id);
+}
+
+double API::VehicleTypeScope::getMaxSpeed(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getMaxSpeed(id) : TraCIAPI::VehicleTypeScope::getMaxSpeed(id);
+}
+
+double API::VehicleTypeScope::getAccel(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getAccel(id) : TraCIAPI::VehicleTypeScope::getAccel(id);
+}
+
+double API::VehicleTypeScope::getDecel(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getDecel(id) : TraCIAPI::VehicleTypeScope::getDecel(id);
+}
+
+double API::VehicleTypeScope::getEmergencyDecel(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getEmergencyDecel(id) : TraCIAPI::VehicleTypeScope::getEmergencyDecel(id);
+}
+
+double API::VehicleTypeScope::getLength(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getLength(id) : TraCIAPI::VehicleTypeScope::getLength(id);
+}
+
+double API::VehicleTypeScope::getWidth(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getWidth(id) : TraCIAPI::VehicleTypeScope::getWidth(id);
+}
+
+double API::VehicleTypeScope::getHeight(const std::string& id) const
+{
+    return embedded() ? libsumo::VehicleType::getHeight(id) : TraCIAPI::VehicleTypeScope::getHeight(id);
+}
+
+namespace libsumo_variables
+{
+
+double getDouble(int command, int var, const std::string& id)
+{
+    switch (command) {
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            switch (var) {
+                case libsumo::VAR_SPEED:
+                    return libsumo::Vehicle::getSpeed(id);
+                case libsumo::VAR_ANGLE:
+                    return libsumo::Vehicle::getAngle(id);
+                case libsumo::VAR_MAXSPEED:
+                    return libsumo::Vehicle::getMaxSpeed(id);
+                case libsumo::VAR_LENGTH:
+                    return libsumo::Vehicle::getLength(id);
+                case libsumo::VAR_WIDTH:
+                    return libsumo::Vehicle::getWidth(id);
+            }
+            break;
+        case libsumo::CMD_GET_PERSON_VARIABLE:
+            switch (var) {
+                case libsumo::VAR_SPEED:
+                    return libsumo::Person::getSpeed(id);
+                case libsumo::VAR_ANGLE:
+                    return libsumo::Person::getAngle(id);
+                case libsumo::VAR_LENGTH:
+                    return libsumo::Person::getLength(id);
+                case libsumo::VAR_WIDTH:
+                    return libsumo::Person::getWidth(id);
+            }
+            break;
+        case libsumo::CMD_GET_SIM_VARIABLE:
+            switch (var) {
+                case libsumo::VAR_TIME:
+                    return libsumo::Simulation::getTime();
+                case libsumo::VAR_DELTA_T:
+                    return libsumo::Simulation::getDeltaT();
+            }
+            break;
+    }
+
+    throw libsumo::TraCIException("double variable " + std::to_string(var) + " is not available via libsumo");
+}
+
+int getInt(int command, int var, const std::string& id)
+{
+    switch (command) {
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            if (var == libsumo::VAR_SIGNALS) {
+                return libsumo::Vehicle::getSignals(id);
+            }
+            break;
+        case libsumo::CMD_GET_SIM_VARIABLE:
+            if (var == libsumo::VAR_TIME_STEP) {
+                return libsumo::Simulation::getCurrentTime();
+            }
+            break;
+    }
+
+    throw libsumo::TraCIException("int variable " + std::to_string(var) + " is not available via libsumo");
+}
+
+libsumo::TraCIPosition getPosition(int command, int var, const std::string& id)
+{
+    if (var == libsumo::VAR_POSITION) {
+        switch (command) {
+            case libsumo::CMD_GET_VEHICLE_VARIABLE:
+                return libsumo::Vehicle::getPosition(id);
+            case libsumo::CMD_GET_PERSON_VARIABLE:
+                return libsumo::Person::getPosition(id);
+        }
+    }
+
+    throw libsumo::TraCIException("position variable " + std::to_string(var) + " is not available via libsumo");
+}
+
+std::string getString(int command, int var, const std::string& id)
+{
+    switch (command) {
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            switch (var) {
+                case libsumo::VAR_TYPE:
+                    return libsumo::Vehicle::getTypeID(id);
+                case libsumo::VAR_VEHICLECLASS:
+                    return libsumo::Vehicle::getVehicleClass(id);
+            }
+            break;
+        case libsumo::CMD_GET_PERSON_VARIABLE:
+            switch (var) {
+                case libsumo::VAR_TYPE:
+                    return libsumo::Person::getTypeID(id);
+                case libsumo::VAR_VEHICLE:
+                    return libsumo::Person::getVehicle(id);
+            }
+            break;
+    }
+
+    throw libsumo::TraCIException("string variable " + std::to_string(var) + " is not available via libsumo");
+}
+
+std::vector<std::string> getStringVector(int command, int var, const std::string& id)
+{
+    if (command == libsumo::CMD_GET_SIM_VARIABLE) {
+        switch (var) {
+            case libsumo::VAR_DEPARTED_VEHICLES_IDS:
+                return libsumo::Simulation::getDepartedIDList();
+            case libsumo::VAR_ARRIVED_VEHICLES_IDS:
+                return libsumo::Simulation::getArrivedIDList();
+            case libsumo::VAR_TELEPORT_STARTING_VEHICLES_IDS:
+                return libsumo::Simulation::getStartingTeleportIDList();
+            case libsumo::VAR_DEPARTED_PERSONS_IDS:
+                return libsumo::Simulation::getDepartedPersonIDList();
+            case libsumo::VAR_ARRIVED_PERSONS_IDS:
+                return libsumo::Simulation::getArrivedPersonIDList();
+        }
+    }
+
+    throw libsumo::TraCIException("string list variable " + std::to_string(var) + " is not available via libsumo");
+}
+
+} // namespace libsumo_variables
+
+} // namespace traci
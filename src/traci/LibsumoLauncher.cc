@@ -0,0 +1,52 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/LibsumoLauncher.h"
+#include <libsumo/Simulation.h>
+#include <iterator>
+#include <sstream>
+
+namespace traci
+{
+
+Define_Module(LibsumoLauncher)
+
+void LibsumoLauncher::initialize()
+{
+    m_sumocfg = par("sumocfg").stringValue();
+    m_extra_options = par("extraOptions").stringValue();
+    m_seed = par("seed");
+}
+
+ServerEndpoint LibsumoLauncher::launch()
+{
+    try {
+        libsumo::Simulation::start(arguments());
+    } catch (libsumo::TraCIException& e) {
+        throw omnetpp::cRuntimeError("Starting embedded SUMO failed: %s", e.what());
+    }
+
+    ServerEndpoint endpoint;
+    endpoint.embedded = true;
+    return endpoint;
+}
+
+std::vector<std::string> LibsumoLauncher::arguments() const
+{
+    std::vector<std::string> args {
+        "sumo",
+        "--seed", std::to_string(m_seed),
+        "--configuration-file", m_sumocfg,
+        "--no-step-log"
+    };
+
+    // split extra options at whitespace like a shell would do for PosixLauncher
+    std::istringstream extra { m_extra_options };
+    std::copy(std::istream_iterator<std::string> { extra }, std::istream_iterator<std::string> {}, std::back_inserter(args));
+
+    return args;
+}
+
+} // namespace traci
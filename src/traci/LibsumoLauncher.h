@@ -0,0 +1,40 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef LIBSUMOLAUNCHER_H_ZP4N8CWE
+#define LIBSUMOLAUNCHER_H_ZP4N8CWE
+
+#include "traci/Launcher.h"
+#include <omnetpp/csimplemodule.h>
+#include <string>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * LibsumoLauncher starts SUMO within the simulation process via libsumo.
+ *
+ * API calls are dispatched directly to SUMO instead of serialising them for a TraCI socket.
+ */
+class LibsumoLauncher : public Launcher, public omnetpp::cSimpleModule
+{
+public:
+    ServerEndpoint launch() override;
+
+protected:
+    void initialize() override;
+
+private:
+    std::vector<std::string> arguments() const;
+
+    std::string m_sumocfg;
+    std::string m_extra_options;
+    int m_seed;
+};
+
+} // namespace traci
+
+#endif /* LIBSUMOLAUNCHER_H_ZP4N8CWE */
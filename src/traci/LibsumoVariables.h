@@ -0,0 +1,36 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef LIBSUMOVARIABLES_H_QW3KDM7T
+#define LIBSUMOVARIABLES_H_QW3KDM7T
+
+#include "traci/sumo/libsumo/TraCIDefs.h"
+#include <string>
+#include <vector>
+
+namespace traci
+{
+namespace libsumo_variables
+{
+
+/**
+ * Retrieve a variable from embedded SUMO by its TraCI identifiers.
+ * Only variables with a VariableTrait are supported, any other throws a libsumo::TraCIException.
+ *
+ * \param command TraCI get command of variable's domain, e.g. CMD_GET_VEHICLE_VARIABLE
+ * \param var TraCI variable identifier
+ * \param id object identifier
+ * \return variable's value
+ */
+double getDouble(int command, int var, const std::string& id);
+int getInt(int command, int var, const std::string& id);
+libsumo::TraCIPosition getPosition(int command, int var, const std::string& id);
+std::string getString(int command, int var, const std::string& id);
+std::vector<std::string> getStringVector(int command, int var, const std::string& id);
+
+} // namespace libsumo_variables
+} // namespace traci
+
+#endif /* LIBSUMOVARIABLES_H_QW3KDM7T */
@@ -48,8 +48,7 @@ VehiclePolicy::Decision RegionOfInterestVehiclePolicy::addVehicle(const std::str
         return Decision::Continue;
     } else {
         /* check if vehicle is in Region of Interest */
-        auto vehicle = m_subscriptions->getVehicleCache(id);
-        if (m_regions.cover(vehicle->get<libsumo::VAR_POSITION>())) {
+        if (cover(id)) {
             /* vehicle was in region and NOT in vehicle list */
             EV_DEBUG << "Vehicle " << id << " is added: departed within region of interest" << endl;
             return Decision::Continue;
@@ -70,8 +69,7 @@ VehiclePolicy::Decision RegionOfInterestVehiclePolicy::updateVehicle(const std::
         return Decision::Continue;
     } else {
         /* check if vehicle is in Region of Interest */
-        auto vehicle = m_subscriptions->getVehicleCache(id);
-        if (m_regions.cover(vehicle->get<libsumo::VAR_POSITION>())) {
+        if (cover(id)) {
             /* vehicle is known and in RoI */
             return Decision::Continue;
         } else {
@@ -86,6 +84,7 @@ VehiclePolicy::Decision RegionOfInterestVehiclePolicy::updateVehicle(const std::
 
 VehiclePolicy::Decision RegionOfInterestVehiclePolicy::removeVehicle(const std::string& id)
 {
+    m_hints.erase(id);
     auto found = m_outside.find(id);
     if (found == m_outside.end()) {
         return Decision::Continue;
@@ -95,14 +94,20 @@ VehiclePolicy::Decision RegionOfInterestVehiclePolicy::removeVehicle(const std::
     }
 }
 
+bool RegionOfInterestVehiclePolicy::cover(const std::string& id)
+{
+    auto vehicle = m_subscriptions->getVehicleCache(id);
+    auto hint = m_hints.emplace(id, RegionsOfInterest::NoHint).first;
+    return m_regions.cover(vehicle->get<libsumo::VAR_POSITION>(), hint->second);
+}
+
 void RegionOfInterestVehiclePolicy::checkRegionOfInterest()
 {
     assert(m_subscriptions);
     assert(m_lifecycle);
 
     for (auto it = m_outside.begin(); it != m_outside.end();) {
-        auto vehicle = m_subscriptions->getVehicleCache(*it);
-        if (m_regions.cover(vehicle->get<libsumo::VAR_POSITION>())) {
+        if (cover(*it)) {
             EV_DEBUG << "Vehicle " << *it << " is added: entered region of interest" << endl;
             m_lifecycle->addVehicle(*it);
             it = m_outside.erase(it);
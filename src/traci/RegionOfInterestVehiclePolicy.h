@@ -3,6 +3,7 @@
 
 #include "traci/RegionsOfInterest.h"
 #include "traci/VehiclePolicy.h"
+#include <unordered_map>
 #include <unordered_set>
 #include <omnetpp/clistener.h>
 
@@ -24,11 +25,13 @@ protected:
 
 private:
     void checkRegionOfInterest();
+    bool cover(const std::string& id);
 
     SubscriptionManager* m_subscriptions;
     VehicleLifecycle* m_lifecycle;
     RegionsOfInterest m_regions;
     std::unordered_set<std::string> m_outside;
+    std::unordered_map<std::string, RegionsOfInterest::Hint> m_hints;
 };
 
 } // namespace traci
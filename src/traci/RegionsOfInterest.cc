@@ -6,6 +6,7 @@
 
 #include "traci/RegionsOfInterest.h"
 #include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/geometry/geometries/register/point.hpp>
 #include <boost/lexical_cast.hpp>
 #include <omnetpp/clog.h>
@@ -15,6 +16,8 @@ BOOST_GEOMETRY_REGISTER_POINT_2D(libsumo::TraCIPosition, double, cs::cartesian,
 namespace traci
 {
 
+constexpr RegionsOfInterest::Hint RegionsOfInterest::NoHint;
+
 void RegionsOfInterest::initialize(const omnetpp::cXMLElement& regions, const Boundary& boundary)
 {
     using omnetpp::cXMLElement;
@@ -38,16 +41,40 @@ void RegionsOfInterest::initialize(const omnetpp::cXMLElement& regions, const Bo
             EV_WARN << "Region is out of scenario boundary!\n";
         }
     }
+
+    // bulk loading packs region envelopes into a well balanced tree
+    std::vector<RtreeValue> envelopes;
+    envelopes.reserve(m_regions.size());
+    for (std::size_t i = 0; i < m_regions.size(); ++i) {
+        envelopes.emplace_back(boost::geometry::return_envelope<Box>(m_regions[i]), i);
+    }
+    m_rtree = Rtree(envelopes.begin(), envelopes.end());
 }
 
 bool RegionsOfInterest::cover(const TraCIPosition& pos) const
 {
-    for (const auto& region : m_regions) {
-        if (boost::geometry::within(pos, region)) {
+    Hint hint = NoHint;
+    return cover(pos, hint);
+}
+
+bool RegionsOfInterest::cover(const TraCIPosition& pos, Hint& hint) const
+{
+    namespace bgi = boost::geometry::index;
+
+    // objects rarely change their region, thus check last covering region first
+    if (hint < m_regions.size() && boost::geometry::within(pos, m_regions[hint])) {
+        return true;
+    }
+
+    const Point point { pos.x, pos.y };
+    for (auto it = m_rtree.qbegin(bgi::intersects(point)); it != m_rtree.qend(); ++it) {
+        if (it->second != hint && boost::geometry::within(pos, m_regions[it->second])) {
+            hint = it->second;
             return true;
         }
     }
 
+    hint = NoHint;
     return false;
 }
 
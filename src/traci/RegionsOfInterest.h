@@ -9,10 +9,15 @@
 
 #include "traci/Boundary.h"
 #include "traci/Position.h"
+#include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <omnetpp/cxmlelement.h>
-#include <list>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace traci
 {
@@ -22,15 +27,31 @@ class RegionsOfInterest
 public:
     using Point = boost::geometry::model::d2::point_xy<double>;
     using Region = boost::geometry::model::polygon<Point>;
+    using Hint = std::size_t;
+    static constexpr Hint NoHint = std::numeric_limits<Hint>::max();
 
     RegionsOfInterest() = default;
     void initialize(const omnetpp::cXMLElement&, const Boundary&);
     bool cover(const TraCIPosition&) const;
+
+    /**
+     * Check if position is covered by any region
+     * \param pos position to check
+     * \param hint region covering a previous position of same object, updated to covering region
+     * \return true if position is covered
+     */
+    bool cover(const TraCIPosition& pos, Hint& hint) const;
+
     std::size_t size() const { return m_regions.size(); }
     bool empty() const { return m_regions.empty(); }
 
 private:
-    std::list<Region> m_regions;
+    using Box = boost::geometry::model::box<Point>;
+    using RtreeValue = std::pair<Box, std::size_t>;
+    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
+
+    std::vector<Region> m_regions;
+    Rtree m_rtree;
 
     static Region buildRegion(const Boundary&);
 };
@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace traci
 {
@@ -31,6 +32,17 @@ public:
     virtual void subscribeSimulationVariables(const std::set<int>& simulationVariables) = 0;
     virtual const std::unordered_set<std::string>& getSubscribedPersons() const = 0;
     virtual const std::unordered_set<std::string>& getSubscribedVehicles() const = 0;
+
+    /**
+     * Vehicles subscribed in last step, i.e. departed or entered a subscription context
+     */
+    virtual const std::vector<std::string>& getAddedVehicles() const = 0;
+
+    /**
+     * Vehicles unsubscribed in last step, i.e. arrived or left all subscription contexts
+     */
+    virtual const std::vector<std::string>& getRemovedVehicles() const = 0;
+
     virtual const std::unordered_map<std::string, std::shared_ptr<VehicleCache>>& getAllVehicleCaches() const = 0;
     virtual std::shared_ptr<PersonCache> getPersonCache(const std::string& id) = 0;
     virtual std::shared_ptr<VehicleCache> getVehicleCache(const std::string& id) = 0;
@@ -0,0 +1,247 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/SubscriptionRecords.h"
+#include "traci/sumo/foreign/tcpip/storage.h"
+#include "traci/sumo/libsumo/TraCIConstants.h"
+#include <memory>
+
+namespace traci
+{
+
+namespace
+{
+
+template<typename T>
+T& slot(std::vector<T>& values, std::size_t& count)
+{
+    if (values.size() <= count) {
+        values.emplace_back();
+    }
+    return values[count++];
+}
+
+} // namespace
+
+void SubscriptionRecord::decode(tcpip::Storage& in, int variableCount)
+{
+    std::size_t doubles = 0;
+    std::size_t integers = 0;
+    std::size_t positions = 0;
+    std::size_t colors = 0;
+    std::size_t strings = 0;
+    std::size_t string_lists = 0;
+
+    m_entries.resize(variableCount);
+    for (Entry& entry : m_entries) {
+        entry.variable = in.readUnsignedByte();
+        const int status = in.readUnsignedByte();
+        entry.type = in.readUnsignedByte();
+
+        if (status != libsumo::RTYPE_OK) {
+            throw libsumo::TraCIException("Subscription response error: variableID=" + std::to_string(entry.variable) + " status=" + std::to_string(status));
+        }
+
+        switch (entry.type) {
+            case libsumo::TYPE_DOUBLE:
+                entry.index = doubles;
+                slot(m_doubles, doubles) = in.readDouble();
+                break;
+            case libsumo::TYPE_INTEGER:
+                entry.index = integers;
+                slot(m_integers, integers) = in.readInt();
+                break;
+            case libsumo::POSITION_2D:
+            case libsumo::POSITION_3D: {
+                entry.index = positions;
+                libsumo::TraCIPosition& position = slot(m_positions, positions);
+                position.x = in.readDouble();
+                position.y = in.readDouble();
+                position.z = entry.type == libsumo::POSITION_3D ? in.readDouble() : 0.0;
+                break;
+            }
+            case libsumo::TYPE_COLOR: {
+                entry.index = colors;
+                libsumo::TraCIColor& color = slot(m_colors, colors);
+                color.r = in.readUnsignedByte();
+                color.g = in.readUnsignedByte();
+                color.b = in.readUnsignedByte();
+                color.a = in.readUnsignedByte();
+                break;
+            }
+            case libsumo::TYPE_STRING:
+                entry.index = strings;
+                slot(m_strings, strings) = in.readString();
+                break;
+            case libsumo::TYPE_STRINGLIST: {
+                entry.index = string_lists;
+                std::vector<std::string>& list = slot(m_string_lists, string_lists);
+                list.resize(in.readInt());
+                for (std::string& item : list) {
+                    item = in.readString();
+                }
+                break;
+            }
+            default:
+                throw libsumo::TraCIException("Unimplemented subscription type: " + std::to_string(entry.type));
+        }
+    }
+
+    // merely shrinks, capacity is retained for following steps
+    m_doubles.resize(doubles);
+    m_integers.resize(integers);
+    m_positions.resize(positions);
+    m_colors.resize(colors);
+    m_strings.resize(strings);
+    m_string_lists.resize(string_lists);
+}
+
+const SubscriptionRecord::Entry* SubscriptionRecord::findEntry(int var, int type) const
+{
+    for (const Entry& entry : m_entries) {
+        if (entry.variable == var) {
+            return entry.type == type ? &entry : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template<>
+const double* SubscriptionRecord::find<double>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::TYPE_DOUBLE);
+    return entry ? &m_doubles[entry->index] : nullptr;
+}
+
+template<>
+const int* SubscriptionRecord::find<int>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::TYPE_INTEGER);
+    return entry ? &m_integers[entry->index] : nullptr;
+}
+
+template<>
+const libsumo::TraCIPosition* SubscriptionRecord::find<libsumo::TraCIPosition>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::POSITION_2D);
+    if (!entry) {
+        entry = findEntry(var, libsumo::POSITION_3D);
+    }
+    return entry ? &m_positions[entry->index] : nullptr;
+}
+
+template<>
+const libsumo::TraCIColor* SubscriptionRecord::find<libsumo::TraCIColor>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::TYPE_COLOR);
+    return entry ? &m_colors[entry->index] : nullptr;
+}
+
+template<>
+const std::string* SubscriptionRecord::find<std::string>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::TYPE_STRING);
+    return entry ? &m_strings[entry->index] : nullptr;
+}
+
+template<>
+const std::vector<std::string>* SubscriptionRecord::find<std::vector<std::string>>(int var) const
+{
+    const Entry* entry = findEntry(var, libsumo::TYPE_STRINGLIST);
+    return entry ? &m_string_lists[entry->index] : nullptr;
+}
+
+libsumo::TraCIResults SubscriptionRecord::results() const
+{
+    libsumo::TraCIResults results;
+    for (const Entry& entry : m_entries) {
+        std::shared_ptr<libsumo::TraCIResult> result;
+        switch (entry.type) {
+            case libsumo::TYPE_DOUBLE:
+                result = std::make_shared<libsumo::TraCIDouble>(m_doubles[entry.index]);
+                break;
+            case libsumo::TYPE_INTEGER:
+                result = std::make_shared<libsumo::TraCIInt>(m_integers[entry.index]);
+                break;
+            case libsumo::POSITION_2D:
+            case libsumo::POSITION_3D:
+                result = std::make_shared<libsumo::TraCIPosition>(m_positions[entry.index]);
+                break;
+            case libsumo::TYPE_COLOR:
+                result = std::make_shared<libsumo::TraCIColor>(m_colors[entry.index]);
+                break;
+            case libsumo::TYPE_STRING:
+                result = std::make_shared<libsumo::TraCIString>(m_strings[entry.index]);
+                break;
+            case libsumo::TYPE_STRINGLIST: {
+                auto list = std::make_shared<libsumo::TraCIStringList>();
+                list->value = m_string_lists[entry.index];
+                result = list;
+                break;
+            }
+        }
+        results[entry.variable] = result;
+    }
+    return results;
+}
+
+void SubscriptionRecords::beginStep()
+{
+    ++m_step;
+    m_updated.clear();
+}
+
+void SubscriptionRecords::decode(tcpip::Storage& in)
+{
+    m_id = in.readString();
+    const int variableCount = in.readUnsignedByte();
+    decodeObject(in, variableCount);
+}
+
+void SubscriptionRecords::decodeContext(tcpip::Storage& in)
+{
+    in.readString(); // ego object
+    in.readUnsignedByte(); // context domain
+    const int variableCount = in.readUnsignedByte();
+    int objectCount = in.readInt();
+    while (objectCount > 0) {
+        m_id = in.readString();
+        decodeObject(in, variableCount);
+        --objectCount;
+    }
+}
+
+void SubscriptionRecords::decodeObject(tcpip::Storage& in, int variableCount)
+{
+    Slot& slot = m_slots[m_id];
+    // an object may be reported by several overlapping contexts
+    if (slot.step != m_step) {
+        m_updated.push_back(m_id);
+    }
+    slot.record.decode(in, variableCount);
+    slot.step = m_step;
+}
+
+const SubscriptionRecord* SubscriptionRecords::find(const std::string& id) const
+{
+    auto found = m_slots.find(id);
+    if (found != m_slots.end() && found->second.step == m_step) {
+        return &found->second.record;
+    }
+    return nullptr;
+}
+
+void SubscriptionRecords::erase(const std::string& id)
+{
+    m_slots.erase(id);
+}
+
+void SubscriptionRecords::clear()
+{
+    m_slots.clear();
+    m_updated.clear();
+}
+
+} // namespace traci
@@ -0,0 +1,140 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef SUBSCRIPTIONRECORDS_H_K2VNXW8E
+#define SUBSCRIPTIONRECORDS_H_K2VNXW8E
+
+#include "traci/sumo/libsumo/TraCIDefs.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tcpip { class Storage; }
+
+namespace traci
+{
+
+/**
+ * SubscriptionRecord holds the decoded subscription variables of a single object.
+ *
+ * Values are stored as plain values in typed arrays instead of one heap object per variable.
+ * A record is reused from step to step: as long as an object's response contains the same
+ * variables, decoding overwrites values in place without any allocation.
+ */
+class SubscriptionRecord
+{
+public:
+    /**
+     * Decode variables of a variable subscription response
+     * \param in storage positioned at first variable
+     * \param variableCount number of variables in response
+     */
+    void decode(tcpip::Storage& in, int variableCount);
+
+    /**
+     * Find value of a variable
+     * \param var variable identifier
+     * \return pointer to value or nullptr if variable is missing or has another type
+     */
+    template<typename T>
+    const T* find(int var) const;
+
+    /**
+     * Convert record to generic TraCI results
+     * \return results with one heap object per variable
+     */
+    libsumo::TraCIResults results() const;
+
+private:
+    struct Entry
+    {
+        int variable;
+        int type;
+        std::size_t index;
+    };
+
+    const Entry* findEntry(int var, int type) const;
+
+    std::vector<Entry> m_entries;
+    std::vector<double> m_doubles;
+    std::vector<int> m_integers;
+    std::vector<libsumo::TraCIPosition> m_positions;
+    std::vector<libsumo::TraCIColor> m_colors;
+    std::vector<std::string> m_strings;
+    std::vector<std::vector<std::string>> m_string_lists;
+};
+
+template<> const double* SubscriptionRecord::find<double>(int) const;
+template<> const int* SubscriptionRecord::find<int>(int) const;
+template<> const libsumo::TraCIPosition* SubscriptionRecord::find<libsumo::TraCIPosition>(int) const;
+template<> const libsumo::TraCIColor* SubscriptionRecord::find<libsumo::TraCIColor>(int) const;
+template<> const std::string* SubscriptionRecord::find<std::string>(int) const;
+template<> const std::vector<std::string>* SubscriptionRecord::find<std::vector<std::string>>(int) const;
+
+/**
+ * SubscriptionRecords collects records of all objects of one domain, e.g. all vehicles.
+ *
+ * Records are kept across steps for reuse, but only those decoded in the current step are found.
+ */
+class SubscriptionRecords
+{
+public:
+    /**
+     * Prepare for decoding the responses of a new simulation step
+     */
+    void beginStep();
+
+    /**
+     * Decode a variable subscription response (object identifier followed by variables)
+     * \param in storage positioned at object identifier
+     */
+    void decode(tcpip::Storage& in);
+
+    /**
+     * Decode a context subscription response, i.e. variables of all objects around an ego object
+     * \param in storage positioned at ego object identifier
+     */
+    void decodeContext(tcpip::Storage& in);
+
+    /**
+     * Find record of an object updated in current step
+     * \param id object identifier
+     * \return record or nullptr
+     */
+    const SubscriptionRecord* find(const std::string& id) const;
+
+    /**
+     * Get identifiers of objects updated in current step
+     * \return identifiers in order of decoding, each only once
+     */
+    const std::vector<std::string>& updated() const { return m_updated; }
+
+    /**
+     * Drop record of an object, e.g. when it has been unsubscribed
+     * \param id object identifier
+     */
+    void erase(const std::string& id);
+
+    void clear();
+
+private:
+    struct Slot
+    {
+        SubscriptionRecord record;
+        unsigned step = 0;
+    };
+
+    void decodeObject(tcpip::Storage& in, int variableCount);
+
+    std::unordered_map<std::string, Slot> m_slots;
+    std::vector<std::string> m_updated;
+    std::string m_id;
+    unsigned m_step = 0;
+};
+
+} // namespace traci
+
+#endif /* SUBSCRIPTIONRECORDS_H_K2VNXW8E */
@@ -5,18 +5,31 @@
  */
 
 #include "traci/VariableCache.h"
+#ifdef WITH_LIBSUMO
+#include "traci/LibsumoVariables.h"
+#endif
 
 namespace traci
 {
 
 VariableCache::VariableCache(std::shared_ptr<API> api, int command, const std::string& id) :
     TraCIScopeWrapper(*api, command, 0, 0, 0), m_api(api), m_id(id)
+#ifdef WITH_LIBSUMO
+    , m_command(command)
+#endif
 {
 }
 
 void VariableCache::reset(const libsumo::TraCIResults& values)
 {
     m_values = values;
+    m_record = nullptr;
+}
+
+void VariableCache::reset(const SubscriptionRecord& record)
+{
+    m_values.clear();
+    m_record = &record;
 }
 
 SimulationCache::SimulationCache(std::shared_ptr<API> api) :
@@ -34,33 +47,69 @@ VehicleCache::VehicleCache(std::shared_ptr<API> api, const std::string& vehicleI
 {
 }
 
+void VehicleCache::attach(const VehicleStateTable& table, VehicleStateTable::Slot slot)
+{
+    m_state_table = &table;
+    m_state_slot = slot;
+}
+
+void VehicleCache::detach()
+{
+    m_state_table = nullptr;
+}
+
 template<>
 double VariableCache::retrieve<double>(int var)
 {
+#ifdef WITH_LIBSUMO
+    if (m_api->isEmbedded()) {
+        return libsumo_variables::getDouble(m_command, var, m_id);
+    }
+#endif
     return TraCIScopeWrapper::getDouble(var, m_id);
 }
 
 template<>
 libsumo::TraCIPosition VariableCache::retrieve<libsumo::TraCIPosition>(int var)
 {
+#ifdef WITH_LIBSUMO
+    if (m_api->isEmbedded()) {
+        return libsumo_variables::getPosition(m_command, var, m_id);
+    }
+#endif
     return TraCIScopeWrapper::getPos(var, m_id);
 }
 
 template<>
 std::string VariableCache::retrieve<std::string>(int var)
 {
+#ifdef WITH_LIBSUMO
+    if (m_api->isEmbedded()) {
+        return libsumo_variables::getString(m_command, var, m_id);
+    }
+#endif
     return TraCIScopeWrapper::getString(var, m_id);
 }
 
 template<>
 std::vector<std::string> VariableCache::retrieve<std::vector<std::string>>(int var)
 {
+#ifdef WITH_LIBSUMO
+    if (m_api->isEmbedded()) {
+        return libsumo_variables::getStringVector(m_command, var, m_id);
+    }
+#endif
     return TraCIScopeWrapper::getStringVector(var, m_id);
 }
 
 template<>
 int VariableCache::retrieve<int>(int var)
 {
+#ifdef WITH_LIBSUMO
+    if (m_api->isEmbedded()) {
+        return libsumo_variables::getInt(m_command, var, m_id);
+    }
+#endif
     return TraCIScopeWrapper::getInt(var, m_id);
 }
 
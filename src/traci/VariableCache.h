@@ -8,8 +8,10 @@
 #define VARIABLECACHE_H_GJG2APIF
 
 #include "traci/API.h"
+#include "traci/SubscriptionRecords.h"
 #include "traci/ValueUtils.h"
 #include "traci/VariableTraits.h"
+#include "traci/VehicleStateTable.h"
 #include <memory>
 #include <string>
 
@@ -36,7 +38,8 @@ public:
 
         auto found = m_values.find(VAR);
         if (found == m_values.end()) {
-            value_type value = retrieve<value_type>(VAR);
+            const value_type* recorded = m_record ? m_record->find<value_type>(VAR) : nullptr;
+            value_type value = recorded ? *recorded : retrieve<value_type>(VAR);
             auto result = std::make_shared<result_type>(make_value(std::move(value)));
             std::tie(found, std::ignore) = m_values.emplace(VAR, std::move(result));
         }
@@ -57,6 +60,12 @@ public:
     typename get_value_trait<typename VariableTrait<VAR>::value_type>::return_type
     {
         using value_type = typename VariableTrait<VAR>::value_type;
+        if (m_record) {
+            // subscribed values are read from the record without allocating result objects
+            if (const value_type* recorded = m_record->find<value_type>(VAR)) {
+                return *recorded;
+            }
+        }
         return get_value<value_type>(this->getPtr<VAR>());
     }
 
@@ -66,6 +75,12 @@ public:
      */
     void reset(const libsumo::TraCIResults& values);
 
+    /**
+     * Reset cache to reference a subscription record
+     * \param record decoded subscription variables, has to outlive cache or its next reset
+     */
+    void reset(const SubscriptionRecord& record);
+
 protected:
     VariableCache(std::shared_ptr<API> api, int command, const std::string& id);
 
@@ -75,7 +90,11 @@ protected:
 private:
     std::shared_ptr<API> m_api;
     const std::string m_id;
+#ifdef WITH_LIBSUMO
+    const int m_command;
+#endif
     libsumo::TraCIResults m_values;
+    const SubscriptionRecord* m_record = nullptr;
 };
 
 class PersonCache : public VariableCache
@@ -90,6 +109,53 @@ class VehicleCache : public VariableCache
 public:
     VehicleCache(std::shared_ptr<API> api, const std::string& vehicleID);
     const std::string& getVehicleId() const { return getId(); }
+
+    /**
+     * Get value from cache.
+     * Variables stored in an attached VehicleStateTable are read directly from its slot.
+     *
+     * \param VAR variable identifier
+     * \return cached value
+     */
+    template<int VAR>
+    auto get() ->
+    typename get_value_trait<typename VariableTrait<VAR>::value_type>::return_type
+    {
+        return getState<VAR>(VehicleStateTable::Column<VAR> {});
+    }
+
+    /**
+     * Attach cache to a slot of a vehicle state table
+     * \param table vehicle state table, has to outlive attachment
+     * \param slot vehicle's slot in table
+     */
+    void attach(const VehicleStateTable& table, VehicleStateTable::Slot slot);
+
+    /**
+     * Detach cache from its vehicle state table, e.g. before its slot is released
+     */
+    void detach();
+
+private:
+    template<int VAR>
+    auto getState(std::true_type) ->
+    typename get_value_trait<typename VariableTrait<VAR>::value_type>::return_type
+    {
+        if (m_state_table && m_state_table->valid(m_state_slot, VAR)) {
+            return VehicleStateTable::Column<VAR>::get(*m_state_table, m_state_slot);
+        }
+        return VariableCache::get<VAR>();
+    }
+
+    template<int VAR>
+    auto getState(std::false_type) ->
+    typename get_value_trait<typename VariableTrait<VAR>::value_type>::return_type
+    {
+        return VariableCache::get<VAR>();
+    }
+
+    const VehicleStateTable* m_state_table = nullptr;
+    VehicleStateTable::Slot m_state_slot = 0;
 };
 
 class SimulationCache : public VariableCache
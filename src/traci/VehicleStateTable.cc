@@ -0,0 +1,113 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/VehicleStateTable.h"
+#include "traci/SubscriptionRecords.h"
+#include <cassert>
+
+namespace traci
+{
+
+namespace
+{
+
+const std::uint8_t sPositionField = 1 << 0;
+const std::uint8_t sSpeedField = 1 << 1;
+const std::uint8_t sAngleField = 1 << 2;
+
+} // namespace
+
+std::uint8_t VehicleStateTable::field(int var)
+{
+    switch (var) {
+        case libsumo::VAR_POSITION:
+            return sPositionField;
+        case libsumo::VAR_SPEED:
+            return sSpeedField;
+        case libsumo::VAR_ANGLE:
+            return sAngleField;
+        default:
+            return 0;
+    }
+}
+
+VehicleStateTable::Slot VehicleStateTable::allocate()
+{
+    if (!m_free_slots.empty()) {
+        Slot slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+    }
+
+    m_positions.emplace_back();
+    m_speeds.push_back(0.0);
+    m_angles.push_back(0.0);
+    m_fields.push_back(0);
+    return m_fields.size() - 1;
+}
+
+void VehicleStateTable::release(Slot slot)
+{
+    assert(slot < capacity());
+    m_fields[slot] = 0;
+    m_free_slots.push_back(slot);
+}
+
+void VehicleStateTable::update(Slot slot, const SubscriptionRecord& record)
+{
+    assert(slot < capacity());
+    std::uint8_t fields = 0;
+
+    if (const libsumo::TraCIPosition* position = record.find<libsumo::TraCIPosition>(libsumo::VAR_POSITION)) {
+        m_positions[slot].x = position->x;
+        m_positions[slot].y = position->y;
+        m_positions[slot].z = position->z;
+        fields |= sPositionField;
+    }
+    if (const double* speed = record.find<double>(libsumo::VAR_SPEED)) {
+        m_speeds[slot] = *speed;
+        fields |= sSpeedField;
+    }
+    if (const double* angle = record.find<double>(libsumo::VAR_ANGLE)) {
+        m_angles[slot] = *angle;
+        fields |= sAngleField;
+    }
+
+    m_fields[slot] = fields;
+}
+
+void VehicleStateTable::update(Slot slot, const libsumo::TraCIResults& results)
+{
+    assert(slot < capacity());
+    std::uint8_t fields = 0;
+
+    auto position = results.find(libsumo::VAR_POSITION);
+    if (position != results.end()) {
+        if (auto value = dynamic_cast<const libsumo::TraCIPosition*>(position->second.get())) {
+            m_positions[slot].x = value->x;
+            m_positions[slot].y = value->y;
+            m_positions[slot].z = value->z;
+            fields |= sPositionField;
+        }
+    }
+    auto speed = results.find(libsumo::VAR_SPEED);
+    if (speed != results.end()) {
+        if (auto value = dynamic_cast<const libsumo::TraCIDouble*>(speed->second.get())) {
+            m_speeds[slot] = value->value;
+            fields |= sSpeedField;
+        }
+    }
+    auto angle = results.find(libsumo::VAR_ANGLE);
+    if (angle != results.end()) {
+        if (auto value = dynamic_cast<const libsumo::TraCIDouble*>(angle->second.get())) {
+            m_angles[slot] = value->value;
+            fields |= sAngleField;
+        }
+    }
+
+    m_fields[slot] = fields;
+}
+
+} // namespace traci
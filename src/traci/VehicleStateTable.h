@@ -0,0 +1,92 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef VEHICLESTATETABLE_H_R8JX2MUA
+#define VEHICLESTATETABLE_H_R8JX2MUA
+
+#include "traci/sumo/libsumo/TraCIConstants.h"
+#include "traci/sumo/libsumo/TraCIDefs.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace traci
+{
+
+class SubscriptionRecord;
+
+/**
+ * VehicleStateTable stores the per-step state of all subscribed vehicles as structure of arrays.
+ *
+ * A slot is assigned to a vehicle at its departure and reused by another vehicle after arrival.
+ * Only variables required by every mobility module are stored, i.e. position, speed and angle.
+ */
+class VehicleStateTable
+{
+public:
+    using Slot = std::size_t;
+
+    /**
+     * Trait telling if a TraCI variable is stored in a column of this table
+     */
+    template<int VAR>
+    struct Column : std::false_type {};
+
+    Slot allocate();
+    void release(Slot);
+    std::size_t capacity() const { return m_fields.size(); }
+
+    /**
+     * Update state of a slot, missing variables are marked invalid
+     * \param slot allocated slot
+     * \param record subscription record of vehicle
+     */
+    void update(Slot slot, const SubscriptionRecord& record);
+    void update(Slot slot, const libsumo::TraCIResults& results);
+
+    /**
+     * Check if slot holds a valid value of a variable
+     * \param slot allocated slot
+     * \param var TraCI variable identifier
+     * \return true if value is valid
+     */
+    bool valid(Slot slot, int var) const { return m_fields[slot] & field(var); }
+
+    const libsumo::TraCIPosition& getPosition(Slot slot) const { return m_positions[slot]; }
+    double getSpeed(Slot slot) const { return m_speeds[slot]; }
+    double getAngle(Slot slot) const { return m_angles[slot]; }
+
+private:
+    static std::uint8_t field(int var);
+
+    std::vector<libsumo::TraCIPosition> m_positions;
+    std::vector<double> m_speeds;
+    std::vector<double> m_angles;
+    std::vector<std::uint8_t> m_fields;
+    std::vector<Slot> m_free_slots;
+};
+
+template<>
+struct VehicleStateTable::Column<libsumo::VAR_POSITION> : std::true_type
+{
+    static const libsumo::TraCIPosition& get(const VehicleStateTable& table, Slot slot) { return table.getPosition(slot); }
+};
+
+template<>
+struct VehicleStateTable::Column<libsumo::VAR_SPEED> : std::true_type
+{
+    static double get(const VehicleStateTable& table, Slot slot) { return table.getSpeed(slot); }
+};
+
+template<>
+struct VehicleStateTable::Column<libsumo::VAR_ANGLE> : std::true_type
+{
+    static double get(const VehicleStateTable& table, Slot slot) { return table.getAngle(slot); }
+};
+
+} // namespace traci
+
+#endif /* VEHICLESTATETABLE_H_R8JX2MUA */
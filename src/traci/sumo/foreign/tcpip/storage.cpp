@@ -40,9 +40,7 @@ namespace tcpip
 	{
 		assert(length >= 0); // fixed MB, 2015-04-21
 
-		store.reserve(length);
-		// Get the content
-		for(int i = 0; i < length; ++i) store.push_back(packet[i]);
+		store.assign(packet, packet + length);
 
 		init();
 	}
@@ -52,7 +50,7 @@ namespace tcpip
 	void Storage::init()
 	{
 		// Initialize local variables
-		iter_ = store.begin();
+		pos_ = 0;
 
 		short a = 0x0102;
 		unsigned char *p_a = reinterpret_cast<unsigned char*>(&a);
@@ -68,55 +66,27 @@ namespace tcpip
 	// ----------------------------------------------------------------------
 	bool Storage::valid_pos()
 	{
-		return (iter_ != store.end());   // this implies !store.empty()
+		return (pos_ < store.size());   // this implies !store.empty()
 	}
 
 
 	// ----------------------------------------------------------------------
 	unsigned int Storage::position() const
 	{
-		// According to C++ standard std::distance will simply compute the iterators
-		// difference for random access iterators as std::vector provides.
-		return static_cast<unsigned int>(std::distance(store.begin(), iter_));
+		return static_cast<unsigned int>(pos_);
 	}
 
 
 	// ----------------------------------------------------------------------
 	void Storage::reset() {
 		store.clear();
-		iter_ = store.begin();
+		pos_ = 0;
 	}
 
 
 	// ----------------------------------------------------------------------
 	void Storage::resetPos() {
-		iter_ = store.begin();
-	}
-
-
-	// ----------------------------------------------------------------------
-	/**
-	* Reads a char form the array
-	* @return The read char (between 0 and 255)
-	*/
-	unsigned char Storage::readChar()
-	{
-		if ( !valid_pos() )
-		{
-			throw std::invalid_argument("Storage::readChar(): invalid position");
-		}
-		return readCharUnsafe();
-	}
-
-
-	// ----------------------------------------------------------------------
-	/**
-	*
-	*/
-	void Storage::writeChar(unsigned char value)
-	{
-		store.push_back(value);
-		iter_ = store.begin();
+		pos_ = 0;
 	}
 
 
@@ -147,31 +117,6 @@ namespace tcpip
 	}
 
 
-	// ----------------------------------------------------------------------
-	/**
-	* Reads an unsigned byte form the array
-	* @return The read byte (between 0 and 255)
-	*/
-	int Storage::readUnsignedByte()
-	{
-		return static_cast<int>(readChar());
-	}
-
-
-	// ----------------------------------------------------------------------
-	/**
-	*
-	*/
-	void Storage::writeUnsignedByte(int value)
-	{
-		if (value < 0 || value > 255)
-		{
-			throw std::invalid_argument("Storage::writeUnsignedByte(): Invalid value, not in [0, 255]");
-		}
-		writeChar( static_cast<unsigned char>( value ));
-	}
-
-
 	// -----------------------------------------------------------------------
 	/**
 	* Reads a string form the array
@@ -179,12 +124,10 @@ namespace tcpip
 	*/
 	std::string Storage::readString()
 	{
-		int len = readInt();
+		const int len = readInt();
 		checkReadSafe(len);
-		StorageType::const_iterator end = iter_;
-		std::advance(end, len);
-		const std::string tmp(iter_, end);
-		iter_ = end;
+		const std::string tmp(reinterpret_cast<const char*>(&store[0]) + pos_, len);
+		pos_ += len;
 		return tmp;
 	}
 
@@ -196,10 +139,8 @@ namespace tcpip
 	*/
 	void Storage::writeString(const std::string &s)
 	{
-		writeInt(static_cast<int>(s.length()));
-
-		store.insert(store.end(), s.begin(), s.end());
-		iter_ = store.begin();
+		unsigned char* dest = writeTo(grow(4 + s.size()), static_cast<int>(s.length()));
+		std::copy(s.begin(), s.end(), dest);
 	}
 
 
@@ -210,12 +151,16 @@ namespace tcpip
     */
     std::vector<std::string> Storage::readStringList()
     {
-        std::vector<std::string> tmp;
-        const int len = readInt();
-        tmp.reserve(len);
-        for (int i = 0; i < len; i++)
+        const int count = readInt();
+        // each string has at least its length prefix
+        checkListSafe(count, 4);
+        std::vector<std::string> tmp(count);
+        for (std::string& item : tmp)
         {
-            tmp.push_back(readString());
+            const int len = readInt();
+            checkReadSafe(len);
+            item.assign(reinterpret_cast<const char*>(&store[0]) + pos_, len);
+            pos_ += len;
         }
         return tmp;
     }
@@ -228,12 +173,12 @@ namespace tcpip
     */
     std::vector<double> Storage::readDoubleList()
     {
-        std::vector<double> tmp;
         const int len = readInt();
-        tmp.reserve(len);
-        for (int i = 0; i < len; i++)
+        checkListSafe(len, 8);
+        std::vector<double> tmp(len);
+        for (double& value : tmp)
         {
-            tmp.push_back(readDouble());
+            value = readUnsafe<double>();
         }
         return tmp;
     }
@@ -246,10 +191,17 @@ namespace tcpip
     */
     void Storage::writeStringList(const std::vector<std::string> &s)
     {
-        writeInt(static_cast<int>(s.size()));
-        for (std::vector<std::string>::const_iterator it = s.begin(); it!=s.end() ; it++)
+        // single allocation for whole list
+        StorageType::size_type size = 4 + 4 * s.size();
+        for (const std::string& item : s)
         {
-            writeString(*it);
+            size += item.size();
+        }
+        unsigned char* dest = writeTo(grow(size), static_cast<int>(s.size()));
+        for (const std::string& item : s)
+        {
+            dest = writeTo(dest, static_cast<int>(item.size()));
+            dest = std::copy(item.begin(), item.end(), dest);
         }
     }
 
@@ -261,10 +213,10 @@ namespace tcpip
     */
     void Storage::writeDoubleList(const std::vector<double> &s)
     {
-        writeInt(static_cast<int>(s.size()));
-        for (std::vector<double>::const_iterator it = s.begin(); it!=s.end() ; it++)
+        unsigned char* dest = writeTo(grow(4 + 8 * s.size()), static_cast<int>(s.size()));
+        for (double value : s)
         {
-            writeDouble(*it);
+            dest = writeTo(dest, value);
         }
     }
 
@@ -300,31 +252,6 @@ namespace tcpip
 	}
 
 
-	// ----------------------------------------------------------------------
-	/**
-	* restores an integer, which was split up in four bytes acording to the
-	* specification, it must have been split by its row byte representation
-	* with MSBF-order
-	*
-	* @return the unspoiled integer value (between -2.147.483.648 and 2.147.483.647)
-	*/
-	int Storage::readInt()
-	{
-		int value = 0;
-		unsigned char *p_value = reinterpret_cast<unsigned char*>(&value);
-		readByEndianess(p_value, 4);
-		return value;
-	}
-
-
-	// ----------------------------------------------------------------------
-	void Storage::writeInt( int value )
-	{
-		unsigned char *p_value = reinterpret_cast<unsigned char*>(&value);
-		writeByEndianess(p_value, 4);
-	}
-
-
 	// ----------------------------------------------------------------------
 	/**
 	* restores a float , which was split up in four bytes acording to the
@@ -350,37 +277,19 @@ namespace tcpip
 	}
 
 
-	// ----------------------------------------------------------------------
-	void Storage::writeDouble( double value )
-	{
-		unsigned char *p_value = reinterpret_cast<unsigned char*>(&value);
-		writeByEndianess(p_value, 8);
-	}
-
-
-	// ----------------------------------------------------------------------
-	double Storage::readDouble( )
-	{
-		double value = 0;
-		unsigned char *p_value = reinterpret_cast<unsigned char*>(&value);
-		readByEndianess(p_value, 8);
-		return value;
-	}
-
-
 	// ----------------------------------------------------------------------
 	void Storage::writePacket(unsigned char* packet, int length)
 	{
-		store.insert(store.end(), &(packet[0]), &(packet[length]));
-		iter_ = store.begin();   // reserve() invalidates iterators
+		store.insert(store.end(), packet, packet + length);
+		pos_ = 0;
 	}
 
 
 	// ----------------------------------------------------------------------
     void Storage::writePacket(const std::vector<unsigned char> &packet)
     {
-        std::copy(packet.begin(), packet.end(), std::back_inserter(store));
-		iter_ = store.begin();
+        store.insert(store.end(), packet.begin(), packet.end());
+		pos_ = 0;
     }
 
 
@@ -388,59 +297,38 @@ namespace tcpip
 	void Storage::writeStorage(tcpip::Storage& other)
 	{
 		// the compiler cannot deduce to use a const_iterator as source
-		store.insert<StorageType::const_iterator>(store.end(), other.iter_, other.store.end());
-		iter_ = store.begin();
-	}
-
-
-	// ----------------------------------------------------------------------
-	void Storage::checkReadSafe(unsigned int num) const 
-	{
-		if (std::distance(iter_, store.end()) < static_cast<int>(num))
-		{
-			std::ostringstream msg;
-			msg << "tcpip::Storage::readIsSafe: want to read "  << num << " bytes from Storage, "
-				<< "but only " << std::distance(iter_, store.end()) << " remaining";
-			throw std::invalid_argument(msg.str());
-		}
+		store.insert<StorageType::const_iterator>(store.end(), other.store.begin() + other.pos_, other.store.end());
+		pos_ = 0;
 	}
 
 
 	// ----------------------------------------------------------------------
-	unsigned char Storage::readCharUnsafe()
+	void Storage::throwReadUnsafe(unsigned int num) const
 	{
-		char hb = *iter_;
-		++iter_;
-		return hb;
+		std::ostringstream msg;
+		msg << "tcpip::Storage::readIsSafe: want to read "  << num << " bytes from Storage, "
+			<< "but only " << store.size() - pos_ << " remaining";
+		throw std::invalid_argument(msg.str());
 	}
 
 
 	// ----------------------------------------------------------------------
-	void Storage::writeByEndianess(const unsigned char * begin, unsigned int size)
+	void Storage::throwListUnsafe(int count, unsigned int itemSize) const
 	{
-		const unsigned char * end = &(begin[size]);
-		if (bigEndian_)
-			store.insert(store.end(), begin, end);
-		else
-			store.insert(store.end(), std::reverse_iterator<const unsigned char *>(end), std::reverse_iterator<const unsigned char *>(begin));
-		iter_ = store.begin();
+		std::ostringstream msg;
+		msg << "tcpip::Storage::readIsSafe: want to read list of " << count << " items of " << itemSize
+			<< " bytes from Storage, but only " << store.size() - pos_ << " bytes remaining";
+		throw std::invalid_argument(msg.str());
 	}
 
 
 	// ----------------------------------------------------------------------
-	void Storage::readByEndianess(unsigned char * array, int size)
+	unsigned char* Storage::grow(StorageType::size_type size)
 	{
-		checkReadSafe(size);
-		if (bigEndian_)
-		{
-			for (int i = 0; i < size; ++i)
-				array[i] = readCharUnsafe();
-		}
-		else
-		{
-			for (int i = size - 1; i >= 0; --i)
-				array[i] = readCharUnsafe();
-		}
+		const StorageType::size_type offset = store.size();
+		store.resize(offset + size);
+		pos_ = 0;
+		return &store[offset];
 	}
 
 
@@ -26,6 +26,8 @@
 
 #ifdef BUILD_TCPIP
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -42,7 +44,8 @@ public:
 
 private:
 	StorageType store;
-	StorageType::const_iterator iter_;
+	/// read position, an index stays valid when the underlying vector grows
+	StorageType::size_type pos_;
 
 	// sortation of bytes forwards or backwards?
 	bool bigEndian_;
@@ -51,13 +54,71 @@ private:
 	void init();
 
 	/// Check if the next \p num bytes can be read safely
-	void checkReadSafe(unsigned int num) const;
+	void checkReadSafe(unsigned int num) const
+	{
+		if (store.size() - pos_ < num) throwReadUnsafe(num);
+	}
+	[[noreturn]] void throwReadUnsafe(unsigned int num) const;
+	/// Check if a list of \p count items, each at least \p itemSize bytes, can be read safely before allocating it
+	void checkListSafe(int count, unsigned int itemSize) const
+	{
+		if (count < 0 || static_cast<StorageType::size_type>(count) > (store.size() - pos_) / itemSize) throwListUnsafe(count, itemSize);
+	}
+	[[noreturn]] void throwListUnsafe(int count, unsigned int itemSize) const;
 	/// Read a byte \em without validity check
-	unsigned char readCharUnsafe();
+	unsigned char readCharUnsafe() { return store[pos_++]; }
+	/// Append \p size uninitialized bytes and return pointer to the first of them
+	unsigned char* grow(StorageType::size_type size);
+	/// Copy \p size bytes of a value in network byte order (big endian)
+	void copyByEndianess(unsigned char * dest, const unsigned char * src, unsigned int size) const
+	{
+		if (bigEndian_)
+			std::memcpy(dest, src, size);
+		else
+			std::reverse_copy(src, src + size, dest);
+	}
 	/// Write \p size elements of array \p begin according to endianess
-	void writeByEndianess(const unsigned char * begin, unsigned int size);
+	void writeByEndianess(const unsigned char * begin, unsigned int size)
+	{
+		// values are at most 8 bytes, inserting a range is cheaper than resizing
+		unsigned char bytes[8];
+		copyByEndianess(bytes, begin, size);
+		store.insert(store.end(), bytes, bytes + size);
+		pos_ = 0;
+	}
 	/// Read \p size elements into \p array according to endianess
-	void readByEndianess(unsigned char * array, int size);
+	void readByEndianess(unsigned char * array, int size)
+	{
+		checkReadSafe(size);
+		copyByEndianess(array, &store[pos_], size);
+		pos_ += size;
+	}
+
+	/// Read value of type \p T without validity check
+	template<typename T>
+	T readUnsafe()
+	{
+		T value;
+		copyByEndianess(reinterpret_cast<unsigned char*>(&value), &store[pos_], sizeof(T));
+		pos_ += sizeof(T);
+		return value;
+	}
+
+	/// Read value of type \p T
+	template<typename T>
+	T read()
+	{
+		checkReadSafe(sizeof(T));
+		return readUnsafe<T>();
+	}
+
+	/// Write value of type \p T into \p dest (pointing into store)
+	template<typename T>
+	unsigned char* writeTo(unsigned char* dest, T value) const
+	{
+		copyByEndianess(dest, reinterpret_cast<const unsigned char*>(&value), sizeof(T));
+		return dest + sizeof(T);
+	}
 
 
 public:
@@ -71,49 +132,69 @@ public:
 	// Destructor
 	virtual ~Storage();
 
-	virtual bool valid_pos();
-	virtual unsigned int position() const;
+	bool valid_pos();
+	unsigned int position() const;
 
 	void reset();
 	void resetPos();
+	/// Reserve capacity for \p size bytes in total, e.g. before writing a large command
+	void reserve(StorageType::size_type size) { store.reserve(size); }
 	/// Dump storage content as series of hex values
 	std::string hexDump() const;
 
-	virtual unsigned char readChar();
-	virtual void writeChar(unsigned char);
-
-	virtual int readByte();
-	virtual void writeByte(int);
-//	virtual void writeByte(unsigned char);
-
-	virtual int readUnsignedByte();
-	virtual void writeUnsignedByte(int);
-
-	virtual std::string readString();
-	virtual void writeString(const std::string& s);
-
-    virtual std::vector<std::string> readStringList();
-    virtual void writeStringList(const std::vector<std::string> &s);
-
-    virtual std::vector<double> readDoubleList();
-    virtual void writeDoubleList(const std::vector<double> &s);
-
-	virtual int readShort();
-	virtual void writeShort(int);
-
-	virtual int readInt();
-	virtual void writeInt(int);
-
-	virtual float readFloat();
-	virtual void writeFloat( float );
-
-	virtual double readDouble();
-	virtual void writeDouble( double );
-
-	virtual void writePacket(unsigned char* packet, int length);
-    virtual void writePacket(const std::vector<unsigned char> &packet);
-
-	virtual void writeStorage(tcpip::Storage& store);
+	unsigned char readChar()
+	{
+		if (pos_ >= store.size())
+		{
+			throw std::invalid_argument("Storage::readChar(): invalid position");
+		}
+		return readCharUnsafe();
+	}
+	void writeChar(unsigned char value)
+	{
+		store.push_back(value);
+		pos_ = 0;
+	}
+
+	int readByte();
+	void writeByte(int);
+//	void writeByte(unsigned char);
+
+	int readUnsignedByte() { return static_cast<int>(readChar()); }
+	void writeUnsignedByte(int value)
+	{
+		if (value < 0 || value > 255)
+		{
+			throw std::invalid_argument("Storage::writeUnsignedByte(): Invalid value, not in [0, 255]");
+		}
+		writeChar(static_cast<unsigned char>(value));
+	}
+
+	std::string readString();
+	void writeString(const std::string& s);
+
+    std::vector<std::string> readStringList();
+    void writeStringList(const std::vector<std::string> &s);
+
+    std::vector<double> readDoubleList();
+    void writeDoubleList(const std::vector<double> &s);
+
+	int readShort();
+	void writeShort(int);
+
+	int readInt() { return read<int>(); }
+	void writeInt(int value) { writeByEndianess(reinterpret_cast<const unsigned char*>(&value), 4); }
+
+	float readFloat();
+	void writeFloat( float );
+
+	double readDouble() { return read<double>(); }
+	void writeDouble(double value) { writeByEndianess(reinterpret_cast<const unsigned char*>(&value), 8); }
+
+	void writePacket(unsigned char* packet, int length);
+    void writePacket(const std::vector<unsigned char> &packet);
+
+	void writeStorage(tcpip::Storage& store);
 
 	// Some enabled functions of the underlying std::list
 	StorageType::size_type size() const { return store.size(); }
@@ -905,15 +905,15 @@ protected:
      * @param[in] ignoreCommandId Whether the returning command id shall be validated
      * @param[in] acknowledgement Pointer to an existing string into which the acknowledgement message shall be inserted
      */
-    void check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0) const;
+    virtual void check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0) const;
 
     /** @brief Validates the result state of a command
      * @return The command Id
      */
     int check_commandGetResult(tcpip::Storage& inMsg, int command, int expectedType = -1, bool ignoreCommandId = false) const;
 
-    bool processGet(int command, int expectedType, bool ignoreCommandId = false);
-    bool processSet(int command);
+    virtual bool processGet(int command, int expectedType, bool ignoreCommandId = false);
+    virtual bool processSet(int command);
     /// @}
 
     void readVariableSubscription(int cmdId, tcpip::Storage& inMsg);